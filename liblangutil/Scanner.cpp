@@ -56,6 +56,10 @@
 
 #include <boost/algorithm/string/classification.hpp>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <optional>
 #include <string_view>
 #include <tuple>
@@ -136,6 +140,68 @@ private:
 	bool m_complete;
 };
 
+namespace
+{
+
+/// @returns the position of the first character at or after @a _position in @a _text that is
+/// (if @a Match is true) or is not (if @a Match is false) one of @a Chars, or the size of
+/// @a _text if there is no such character. Compares 16 characters at a time if SSE2 is available.
+template <bool Match, char... Chars>
+size_t findFirst(string_view _text, size_t _position)
+{
+#if defined(__SSE2__)
+	for (; _position + 16 <= _text.size(); _position += 16)
+	{
+		__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_text.data() + _position));
+		__m128i matches = _mm_setzero_si128();
+		((matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(Chars)))), ...);
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+		if (!Match)
+			mask = ~mask & 0xffffu;
+		if (mask)
+			return _position + static_cast<size_t>(__builtin_ctz(mask));
+	}
+#endif
+	for (; _position < _text.size(); ++_position)
+		if (((_text[_position] == Chars) || ...) == Match)
+			break;
+	return _position;
+}
+
+template <char... Chars>
+size_t findFirstOf(string_view _text, size_t _position)
+{
+	return findFirst<true, Chars...>(_text, _position);
+}
+
+template <char... Chars>
+size_t findFirstNotOf(string_view _text, size_t _position)
+{
+	return findFirst<false, Chars...>(_text, _position);
+}
+
+/// @returns the position of the next character at or after @a _position that might start
+/// a line terminator as recognized by Scanner::isUnicodeLinebreak().
+size_t findLinebreakCandidate(string_view _text, size_t _position)
+{
+	return findFirstOf<'\n', '\v', '\f', '\r', '\xC2', '\xE2'>(_text, _position);
+}
+
+/// @returns true if @a _char can be copied into the literal of a string delimited by @a _quote
+/// without further checks.
+bool isPlainStringCharacter(char _char, char _quote, bool _isUnicode)
+{
+	if (_char == _quote || _char == '\\')
+		return false;
+	auto const c = static_cast<uint8_t>(_char);
+	if (_isUnicode)
+		return (c < 0x0a || c > 0x0d) && c != 0xc2 && c != 0xe2;
+	else
+		return 0x20 <= c && c <= 0x7e;
+}
+
+}
+
 void Scanner::reset()
 {
 	m_source.reset();
@@ -247,11 +313,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 
 bool Scanner::skipWhitespace()
 {
-	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	if (!isWhiteSpace(m_char))
+		return false;
+	// m_char is not necessarily the character at the current position (see skipMultiLineComment()),
+	// so it is consumed before the rest of the whitespace is skipped in bulk.
+	advance();
+	m_char = m_source.setPosition(findFirstNotOf<' ', '\n', '\t', '\r'>(m_source.source(), sourcePos()));
+	return true;
 }
 
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
@@ -287,7 +355,13 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All of the sequences start with the byte 0xE2, so other positions can be skipped.
+	string_view const text = string_view(_stream.source()).substr(0, endPosition);
+	for (
+		size_t currentPos = findFirstOf<'\xE2'>(text, _startPosition);
+		currentPos < endPosition;
+		currentPos = findFirstOf<'\xE2'>(text, currentPos + 1)
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -311,9 +385,8 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
-			break;
+	while (!isUnicodeLinebreak() && !isSourcePastEndOfInput())
+		m_char = m_source.setPosition(findLinebreakCandidate(m_source.source(), sourcePos() + 1));
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -381,8 +454,13 @@ size_t Scanner::scanSingleLineDocComment()
 			// Any line terminator that is not '\n' is considered to end the
 			// comment.
 			break;
-		addCommentLiteralChar(m_char);
-		advance();
+		// Copy the current character and all following ones up to a potential line terminator.
+		size_t const runStart = sourcePos();
+		size_t const runEnd = findLinebreakCandidate(m_source.source(), runStart + 1);
+		m_skippedComments[NextNext].literal.append(m_source.source(), runStart, runEnd - runStart);
+		if (runEnd > runStart + 1)
+			endPosition = runEnd - 1;
+		m_char = m_source.setPosition(runEnd);
 	}
 	literal.complete();
 	return endPosition;
@@ -391,16 +469,18 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source.position();
-	while (!isSourcePastEndOfInput())
-	{
-		char prevChar = m_char;
-		advance();
-
+	string const& source = m_source.source();
+	for (
+		size_t position = findFirstOf<'*'>(source, startPosition);
+		position + 1 < source.size();
+		position = findFirstOf<'*'>(source, position + 1)
+	)
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
+		if (source[position + 1] == '/')
 		{
+			m_char = m_source.setPosition(position + 1);
 			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 			if (unicodeDirectionError != ScannerError::NoError)
 				return setError(unicodeDirectionError);
@@ -408,8 +488,8 @@ Token Scanner::skipMultiLineComment()
 			m_char = ' ';
 			return Token::Whitespace;
 		}
-	}
 	// Unterminated multi-line comment.
+	m_char = m_source.setPosition(source.size());
 	return setError(ScannerError::IllegalCommentTerminator);
 }
 
@@ -457,9 +537,18 @@ Token Scanner::scanMultiLineDocComment()
 			endFound = true;
 			break;
 		}
-		addCommentLiteralChar(m_char);
+		// Copy the current character and all following ones up to the next line break or '*'.
+		// Skipping whitespace above might have reached the end of the input.
+		if (isSourcePastEndOfInput())
+			addCommentLiteralChar(m_char);
+		else
+		{
+			size_t const runStart = sourcePos();
+			size_t const runEnd = findFirstOf<'\n', '\r', '*'>(m_source.source(), runStart + 1);
+			m_skippedComments[NextNext].literal.append(m_source.source(), runStart, runEnd - runStart);
+			m_char = m_source.setPosition(runEnd);
+		}
 		charsAdded = true;
-		advance();
 	}
 	literal.complete();
 	if (!endFound)
@@ -826,8 +915,21 @@ Token Scanner::scanString(bool const _isUnicode)
 	char const quote = m_char;
 	advance();  // consume quote
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
+	string const& source = m_source.source();
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		// Copy characters that need no special treatment in bulk.
+		size_t const runStart = sourcePos();
+		size_t runEnd = runStart;
+		while (runEnd < source.size() && isPlainStringCharacter(source[runEnd], quote, _isUnicode))
+			++runEnd;
+		if (runEnd != runStart)
+		{
+			m_tokens[NextNext].literal.append(source, runStart, runEnd - runStart);
+			m_char = m_source.setPosition(runEnd);
+			continue;
+		}
+
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -1010,10 +1112,14 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	// Scan the rest of the identifier characters and copy them at once.
+	string const& source = m_source.source();
+	size_t const start = sourcePos();
+	size_t end = start + 1;
+	while (end < source.size() && (isIdentifierPart(source[end]) || (source[end] == '.' && m_kind == ScannerKind::Yul)))
+		++end;
+	m_tokens[NextNext].literal.assign(source, start, end - start);
+	m_char = m_source.setPosition(end);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
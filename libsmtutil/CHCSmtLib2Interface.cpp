@@ -89,23 +89,7 @@ void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
 {
-	string accumulated{};
-	swap(m_accumulatedOutput, accumulated);
-	solAssert(m_smtlib2, "");
-	writeHeader();
-	for (auto const& decl: m_smtlib2->userSorts() | ranges::views::values)
-		write(decl);
-	m_accumulatedOutput += accumulated;
-
-	string queryRule = "(assert\n(forall " + forall() + "\n" +
-		"(=> " + _block.name + " false)"
-		"))";
-	string response = querySolver(
-		m_accumulatedOutput +
-		queryRule +
-		"\n(check-sat)"
-	);
-	swap(m_accumulatedOutput, accumulated);
+	string response = querySolver(dumpQuery(_block));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -121,6 +105,24 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface
 	return {result, Expression(true), {}};
 }
 
+string CHCSmtLib2Interface::dumpQuery(Expression const& _block)
+{
+	string accumulated{};
+	swap(m_accumulatedOutput, accumulated);
+	solAssert(m_smtlib2, "");
+	writeHeader();
+	for (auto const& decl: m_smtlib2->userSorts() | ranges::views::values)
+		write(decl);
+	m_accumulatedOutput += accumulated;
+
+	string queryRule = "(assert\n(forall " + forall() + "\n" +
+		"(=> " + _block.name + " false)"
+		"))";
+	string query = m_accumulatedOutput + queryRule + "\n(check-sat)";
+	swap(m_accumulatedOutput, accumulated);
+	return query;
+}
+
 void CHCSmtLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort);
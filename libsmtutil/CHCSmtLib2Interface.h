@@ -48,6 +48,8 @@ public:
 	/// @returns solving result, an invariant, and counterexample graph, if possible.
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	std::string dumpQuery(Expression const& _expr) override;
+
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	std::vector<std::string> unhandledQueries() const { return m_unhandledQueries; }
@@ -59,6 +59,10 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// @returns a textual representation of the Horn system together with
+	/// the reachability query for _expr, as it would be passed to the solver.
+	virtual std::string dumpQuery(Expression const& _expr) = 0;
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
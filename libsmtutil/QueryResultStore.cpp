@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryResultStore.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// @returns a name for a temporary file that is not used by any other thread or process
+/// writing to the same directory at the same time.
+string temporaryFileName(string const& _prefix)
+{
+	// The token distinguishes processes, the counter distinguishes the files of one process.
+	static uint64_t const processToken = (static_cast<uint64_t>(random_device{}()) << 32) ^ random_device{}();
+	static atomic<uint64_t> counter{0};
+	return _prefix + "-" + to_string(processToken) + "-" + to_string(counter++) + ".tmp";
+}
+
+}
+
+h256 QueryResultStore::key(string const& _query, string const& _solvers, optional<unsigned> _timeout)
+{
+	return keccak256(
+		_solvers + '\n' +
+		(_timeout ? to_string(*_timeout) : "none") + '\n' +
+		_query
+	);
+}
+
+optional<pair<CheckResult, vector<string>>> QueryResultStore::load(h256 const& _key) const
+{
+	fs::path const path = m_directory / _key.hex();
+	// Reading from a directory throws instead of failing the stream.
+	boost::system::error_code error;
+	if (!fs::is_regular_file(path, error))
+		return nullopt;
+	ifstream file(path.string(), ios::binary);
+	if (!file)
+		return nullopt;
+	string content{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+
+	vector<string> lines;
+	boost::split(lines, content, boost::is_any_of("\n"));
+	// Every line, including the last one, is terminated by a newline.
+	if (lines.size() < 2 || !lines.back().empty())
+		return nullopt;
+	lines.pop_back();
+
+	CheckResult result;
+	if (lines.front() == "sat")
+		result = CheckResult::SATISFIABLE;
+	else if (lines.front() == "unsat")
+		result = CheckResult::UNSATISFIABLE;
+	else
+		return nullopt;
+	return make_pair(result, vector<string>(next(lines.begin()), lines.end()));
+}
+
+void QueryResultStore::store(h256 const& _key, CheckResult _result, vector<string> const& _values) const
+{
+	if (_result != CheckResult::SATISFIABLE && _result != CheckResult::UNSATISFIABLE)
+		return;
+
+	string content = _result == CheckResult::SATISFIABLE ? "sat\n" : "unsat\n";
+	for (auto const& value: _values)
+	{
+		// Values are stored one per line.
+		if (value.find('\n') != string::npos)
+			return;
+		content += value + '\n';
+	}
+
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first so that concurrent readers never see partial results.
+	fs::path temporaryPath = m_directory / temporaryFileName(_key.hex());
+	bool written = false;
+	{
+		ofstream file(temporaryPath.string(), ios::binary);
+		written = static_cast<bool>(file << content);
+	}
+	if (written)
+		fs::rename(temporaryPath, m_directory / _key.hex(), error);
+	if (!written || error)
+		fs::remove(temporaryPath, error);
+}
@@ -0,0 +1,63 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Persists the results of SMT queries as one file per query in a directory,
+ * so that later compiler runs can reuse them instead of invoking a solver.
+ *
+ * Only conclusive results (SAT or UNSAT) are stored.
+ * Files are written atomically, so the same directory can be used
+ * by several threads and processes at the same time.
+ */
+class QueryResultStore
+{
+public:
+	explicit QueryResultStore(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the key of a query given as text, as answered by the solvers
+	/// identified by @a _solvers with the given timeout.
+	static util::h256 key(std::string const& _query, std::string const& _solvers, std::optional<unsigned> _timeout);
+
+	/// @returns the result and model values stored for @a _key, if any.
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> load(util::h256 const& _key) const;
+
+	/// Stores @a _result and @a _values for @a _key.
+	/// Does nothing for inconclusive results or if the result cannot be written.
+	void store(util::h256 const& _key, CheckResult _result, std::vector<std::string> const& _values) const;
+
+private:
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -116,10 +116,7 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response = querySolver(dumpQuery(_expressionsToEvaluate));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -138,6 +135,12 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 	return make_pair(result, values);
 }
 
+string SMTLib2Interface::dumpQuery(vector<Expression> const& _expressionsToEvaluate)
+{
+	return boost::algorithm::join(m_accumulatedOutput, "\n") +
+		checkSatAndGetValuesCommand(_expressionsToEvaluate);
+}
+
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
 	if (_expr.arguments.empty())
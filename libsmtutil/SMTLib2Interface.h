@@ -59,6 +59,9 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// @returns the SMT-LIB2 script that check() sends to the solver.
+	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
+
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
 	std::string toSmtLibSort(Sort const& _sort);
@@ -26,48 +26,211 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 using namespace solidity::smtutil;
 
+namespace solidity::smtutil
+{
+
+/**
+ * Owns a solver and applies operations to it, in the order in which they were
+ * enqueued, on a dedicated thread.
+ */
+class ConcurrentSolver
+{
+public:
+	using Operation = function<void(SolverInterface&)>;
+
+	explicit ConcurrentSolver(unique_ptr<SolverInterface> _solver):
+		m_solver(move(_solver)),
+		m_thread([this]() { run(); })
+	{}
+
+	/// Stops the solver and waits for its thread to finish.
+	~ConcurrentSolver()
+	{
+		stop();
+		m_thread.join();
+	}
+
+	/// Drops the operations that did not start yet and interrupts the running one.
+	/// No operations can be enqueued afterwards.
+	void stop()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (m_stopped)
+				return;
+			m_stopped = true;
+			m_operations.clear();
+		}
+		m_condition.notify_one();
+		m_solver->interrupt();
+	}
+
+	void enqueue(Operation _operation)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			smtAssert(!m_stopped, "");
+			m_operations.emplace_back(move(_operation));
+		}
+		m_condition.notify_one();
+	}
+
+	/// @returns and clears the first exception thrown by an operation, if any.
+	exception_ptr takeException()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return exchange(m_exception, nullptr);
+	}
+
+private:
+	void run()
+	{
+		while (true)
+		{
+			Operation operation;
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_condition.wait(lock, [&]() { return m_stopped || !m_operations.empty(); });
+				if (m_stopped)
+					return;
+				operation = move(m_operations.front());
+				m_operations.pop_front();
+			}
+			try
+			{
+				operation(*m_solver);
+			}
+			catch (...)
+			{
+				lock_guard<mutex> lock(m_mutex);
+				if (!m_exception)
+					m_exception = current_exception();
+			}
+		}
+	}
+
+	unique_ptr<SolverInterface> m_solver;
+	mutex m_mutex;
+	condition_variable m_condition;
+	deque<Operation> m_operations;
+	bool m_stopped = false;
+	exception_ptr m_exception;
+	/// Declared last so that it starts after all other members are initialized.
+	thread m_thread;
+};
+
+}
+
 SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	unsigned _threads,
+	shared_ptr<QueryResultStore const> _resultStore
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_resultStore(move(_resultStore))
 {
 	if (_enabledSolvers.smtlib2)
+	{
 		m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+		m_solverNames += "smtlib2;";
+	}
+
+	vector<unique_ptr<SolverInterface>> linkedSolvers;
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
-		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+	{
+		linkedSolvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solverNames += "z3 " + Z3Interface::version() + ";";
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
-		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+	{
+		linkedSolvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solverNames += "cvc4;";
+	}
 #endif
+
+	// The SMT-LIB2 interface relies on the read callback, which is not thread-safe,
+	// so it always stays on the calling thread.
+	addLinkedSolvers(move(linkedSolvers), _threads);
+
+	if (m_resultStore)
+		m_queryPrinter = make_unique<SMTLib2Interface>(map<h256, string>{}, ReadCallback::Callback{}, m_queryTimeout);
+}
+
+SMTPortfolio::SMTPortfolio(
+	vector<unique_ptr<SolverInterface>> _solvers,
+	optional<unsigned> _queryTimeout,
+	unsigned _threads
+):
+	SolverInterface(_queryTimeout)
+{
+	addLinkedSolvers(move(_solvers), _threads);
+}
+
+SMTPortfolio::~SMTPortfolio()
+{
+	// Interrupt all solvers before waiting for any of them.
+	for (auto const& s: m_concurrentSolvers)
+		s->stop();
+}
+
+void SMTPortfolio::addLinkedSolvers(vector<unique_ptr<SolverInterface>> _solvers, unsigned _threads)
+{
+	// Racing a single solver would only add overhead.
+	bool race = _threads > 1 && _solvers.size() > 1;
+	for (auto& solver: _solvers)
+		if (race)
+			m_concurrentSolvers.emplace_back(make_unique<ConcurrentSolver>(move(solver)));
+		else
+			m_solvers.emplace_back(move(solver));
 }
 
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	for (auto const& s: m_concurrentSolvers)
+		s->enqueue([](SolverInterface& _solver) { _solver.reset(); });
+	if (m_queryPrinter)
+		m_queryPrinter->reset();
 }
 
 void SMTPortfolio::push()
 {
 	for (auto const& s: m_solvers)
 		s->push();
+	for (auto const& s: m_concurrentSolvers)
+		s->enqueue([](SolverInterface& _solver) { _solver.push(); });
+	if (m_queryPrinter)
+		m_queryPrinter->push();
 }
 
 void SMTPortfolio::pop()
 {
 	for (auto const& s: m_solvers)
 		s->pop();
+	for (auto const& s: m_concurrentSolvers)
+		s->enqueue([](SolverInterface& _solver) { _solver.pop(); });
+	if (m_queryPrinter)
+		m_queryPrinter->pop();
 }
 
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
@@ -75,12 +238,20 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	for (auto const& s: m_concurrentSolvers)
+		s->enqueue([_name, _sort](SolverInterface& _solver) { _solver.declareVariable(_name, _sort); });
+	if (m_queryPrinter)
+		m_queryPrinter->declareVariable(_name, _sort);
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
 	for (auto const& s: m_solvers)
 		s->addAssertion(_expr);
+	for (auto const& s: m_concurrentSolvers)
+		s->enqueue([_expr](SolverInterface& _solver) { _solver.addAssertion(_expr); });
+	if (m_queryPrinter)
+		m_queryPrinter->addAssertion(_expr);
 }
 
 /*
@@ -112,33 +283,124 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * Solvers that race each other (see raceConcurrentSolvers) count as a single solver here:
+ * only one answer among them is used, so conflicts between them are not detected.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	if (!m_resultStore)
+		return checkSolvers(_expressionsToEvaluate);
+
+	h256 key = QueryResultStore::key(m_queryPrinter->dumpQuery(_expressionsToEvaluate), m_solverNames, m_queryTimeout);
+	if (auto storedResult = m_resultStore->load(key))
+		return *storedResult;
+	auto [result, values] = checkSolvers(_expressionsToEvaluate);
+	m_resultStore->store(key, result, values);
+	return {result, move(values)};
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkSolvers(vector<Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
 	for (auto const& s: m_solvers)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		auto [result, values] = s->check(_expressionsToEvaluate);
+		combineResults(lastResult, finalValues, result, move(values));
+		if (lastResult == CheckResult::CONFLICTING)
+			break;
+	}
+	if (!m_concurrentSolvers.empty() && lastResult != CheckResult::CONFLICTING)
+	{
+		auto [result, values] = raceConcurrentSolvers(_expressionsToEvaluate);
+		combineResults(lastResult, finalValues, result, move(values));
+	}
+	return make_pair(lastResult, finalValues);
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::raceConcurrentSolvers(vector<Expression> const& _expressionsToEvaluate)
+{
+	struct Race
+	{
+		/// Sets the answer as soon as it no longer depends on the solvers that are still running.
+		/// UNSAT carries no values, so the first UNSAT is the answer. A SAT answer is only used
+		/// once all solvers before it returned without answering, so that the values are the
+		/// same as when the solvers are queried sequentially, no matter which one is faster.
+		void decide()
 		{
-			if (!solverAnswered(lastResult))
+			if (answer)
+				return;
+			for (auto const& result: results)
+				if (result && result->first == CheckResult::UNSATISFIABLE)
+				{
+					answer = result;
+					return;
+				}
+			CheckResult fallback = CheckResult::ERROR;
+			for (auto const& result: results)
+				if (!result)
+					return;
+				else if (result->first == CheckResult::SATISFIABLE)
+				{
+					answer = result;
+					return;
+				}
+				else if (result->first == CheckResult::UNKNOWN)
+					fallback = CheckResult::UNKNOWN;
+			answer = make_pair(fallback, vector<string>{});
+		}
+
+		mutex answerMutex;
+		condition_variable answered;
+		/// The results of the solvers that finished the query, in the order of the solvers.
+		vector<optional<pair<CheckResult, vector<string>>>> results;
+		optional<pair<CheckResult, vector<string>>> answer;
+		exception_ptr exception;
+	};
+	// Solvers that lose the race still hold a reference to it after this function returns.
+	auto race = make_shared<Race>();
+	race->results.resize(m_concurrentSolvers.size());
+
+	for (size_t index = 0; index < m_concurrentSolvers.size(); ++index)
+		m_concurrentSolvers[index]->enqueue([race, index, _expressionsToEvaluate](SolverInterface& _solver) {
 			{
-				lastResult = result;
-				finalValues = std::move(values);
+				lock_guard<mutex> lock(race->answerMutex);
+				// The race is already decided, there is no need to run the query.
+				if (race->answer)
+					return;
 			}
-			else if (lastResult != result)
+			pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+			exception_ptr exception;
+			try
 			{
-				lastResult = CheckResult::CONFLICTING;
-				break;
+				result = _solver.check(_expressionsToEvaluate);
 			}
-		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
-	}
-	return make_pair(lastResult, finalValues);
+			catch (...)
+			{
+				exception = current_exception();
+			}
+			{
+				lock_guard<mutex> lock(race->answerMutex);
+				if (exception && !race->exception)
+					race->exception = exception;
+				race->results[index] = move(result);
+				race->decide();
+			}
+			race->answered.notify_one();
+		});
+
+	unique_lock<mutex> lock(race->answerMutex);
+	race->answered.wait(lock, [&]() { return race->answer.has_value(); });
+
+	// Internal errors in any of the operations leading up to the query are reported here.
+	for (auto const& s: m_concurrentSolvers)
+		if (exception_ptr exception = s->takeException())
+			rethrow_exception(exception);
+
+	if (!solverAnswered(race->answer->first) && race->exception)
+		rethrow_exception(race->exception);
+	return *race->answer;
 }
 
 vector<string> SMTPortfolio::unhandledQueries()
@@ -155,3 +417,24 @@ bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
 }
+
+void SMTPortfolio::combineResults(
+	CheckResult& io_result,
+	vector<string>& io_values,
+	CheckResult _result,
+	vector<string> _values
+)
+{
+	if (solverAnswered(_result))
+	{
+		if (!solverAnswered(io_result))
+		{
+			io_result = _result;
+			io_values = move(_values);
+		}
+		else if (io_result != _result)
+			io_result = CheckResult::CONFLICTING;
+	}
+	else if (_result == CheckResult::UNKNOWN && io_result == CheckResult::ERROR)
+		io_result = _result;
+}
@@ -19,21 +19,35 @@
 #pragma once
 
 
+#include <libsmtutil/QueryResultStore.h>
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+class ConcurrentSolver;
+class SMTLib2Interface;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ *
+ * If more than one thread is allowed, the directly linked solvers run on their own
+ * threads and race each other: a query is answered as soon as the answer no longer
+ * depends on the solvers that are still running (see raceConcurrentSolvers).
+ * Those skip the query if it did not start yet. The solvers that are still running
+ * when the portfolio is destroyed are interrupted.
+ *
+ * If a result store is given, conclusive results are looked up in and added to it,
+ * keyed by the SMT-LIB2 text of the query, the enabled solvers and the timeout.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,8 +60,17 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		unsigned _threads = 1,
+		std::shared_ptr<QueryResultStore const> _resultStore = nullptr
+	);
+	/// Creates a portfolio of the given solvers, which race each other if more than one thread is allowed.
+	SMTPortfolio(
+		std::vector<std::unique_ptr<SolverInterface>> _solvers,
+		std::optional<unsigned> _queryTimeout = {},
+		unsigned _threads = 1
 	);
+	~SMTPortfolio() override;
 
 	void reset() override;
 
@@ -61,11 +84,33 @@ public:
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
 	std::vector<std::string> unhandledQueries() override;
-	size_t solvers() override { return m_solvers.size(); }
+	size_t solvers() override { return m_solvers.size() + m_concurrentSolvers.size(); }
 private:
+	/// Adds solvers that can run on their own threads, which they do if more than one thread is allowed.
+	void addLinkedSolvers(std::vector<std::unique_ptr<SolverInterface>> _solvers, unsigned _threads);
 	static bool solverAnswered(CheckResult result);
+	/// Combines the result of a solver with the combined results of the previously queried solvers.
+	static void combineResults(
+		CheckResult& io_result,
+		std::vector<std::string>& io_values,
+		CheckResult _result,
+		std::vector<std::string> _values
+	);
+	/// Queries the concurrent solvers and @returns the first UNSAT answer, the SAT answer
+	/// of the first solver in order that answered, or UNKNOWN or ERROR if none of them answered.
+	std::pair<CheckResult, std::vector<std::string>> raceConcurrentSolvers(std::vector<Expression> const& _expressionsToEvaluate);
+	std::pair<CheckResult, std::vector<std::string>> checkSolvers(std::vector<Expression> const& _expressionsToEvaluate);
 
+	/// Solvers that are queried sequentially on the calling thread.
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// Solvers that run on their own threads and race each other.
+	std::vector<std::unique_ptr<ConcurrentSolver>> m_concurrentSolvers;
+
+	std::shared_ptr<QueryResultStore const> m_resultStore;
+	/// Only used to render queries as SMT-LIB2 for the result store.
+	std::unique_ptr<SMTLib2Interface> m_queryPrinter;
+	/// Identifies the enabled solvers in the keys of the result store.
+	std::string m_solverNames;
 
 	std::vector<Expression> m_assertions;
 };
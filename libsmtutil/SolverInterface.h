@@ -115,6 +115,57 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+/**
+ * Vector whose copies share their elements until one of them is modified.
+ * Used for the arguments of expressions, so that copying an expression does not
+ * copy its subexpressions, and so that solver interfaces can memoise the translation
+ * of subexpressions that are used in several places.
+ */
+template <typename T>
+class SharedVector
+{
+public:
+	SharedVector() = default;
+	SharedVector(std::vector<T> _elements):
+		m_elements(_elements.empty() ? nullptr : std::make_shared<std::vector<T>>(std::move(_elements)))
+	{}
+
+	bool empty() const { return !m_elements; }
+	size_t size() const { return m_elements ? m_elements->size() : 0; }
+
+	T const& at(size_t _index) const { return elements().at(_index); }
+	T const& operator[](size_t _index) const { return (*m_elements)[_index]; }
+	T const& front() const { return elements().front(); }
+	T const& back() const { return elements().back(); }
+
+	auto begin() const { return elements().begin(); }
+	auto end() const { return elements().end(); }
+	/// Mutable iteration detaches the elements from all copies.
+	auto begin() { return m_elements ? mutableElements().begin() : typename std::vector<T>::iterator{}; }
+	auto end() { return m_elements ? mutableElements().end() : typename std::vector<T>::iterator{}; }
+
+	operator std::vector<T> const&() const { return elements(); }
+
+	/// @returns an owning pointer that identifies the elements shared by this vector and its copies,
+	/// or nullptr if the vector is empty. The elements are never modified while it is held.
+	std::shared_ptr<void const> identity() const { return m_elements; }
+
+private:
+	std::vector<T> const& elements() const
+	{
+		static std::vector<T> const empty;
+		return m_elements ? *m_elements : empty;
+	}
+	std::vector<T>& mutableElements()
+	{
+		if (m_elements.use_count() > 1)
+			m_elements = std::make_shared<std::vector<T>>(*m_elements);
+		return *m_elements;
+	}
+
+	std::shared_ptr<std::vector<T>> m_elements;
+};
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
@@ -486,7 +537,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	SharedVector<Expression> arguments;
 	SortPointer sort;
 
 private:
@@ -531,6 +582,10 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a check() running on another thread to return as soon as possible.
+	/// May be called from any thread. The solver must not be queried afterwards.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
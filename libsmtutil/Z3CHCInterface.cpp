@@ -59,7 +59,8 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
-	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	z3::func_decl relation = m_z3Interface->functions().at(_expr.name);
+	m_solver.register_relation(relation);
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
@@ -128,6 +129,13 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 	return {result, Expression(true), {}};
 }
 
+string Z3CHCInterface::dumpQuery(Expression const& _expr)
+{
+	z3::expr_vector queries(*m_context);
+	queries.push_back(m_z3Interface->toZ3Expr(_expr));
+	return m_solver.to_string(queries);
+}
+
 void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 {
 	// Spacer options.
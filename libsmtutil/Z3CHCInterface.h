@@ -45,6 +45,8 @@ public:
 
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	std::string dumpQuery(Expression const& _expr) override;
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
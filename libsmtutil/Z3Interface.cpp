@@ -38,6 +38,16 @@ bool Z3Interface::available()
 #endif
 }
 
+string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision);
+}
+
 Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(m_context)
@@ -55,6 +65,7 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_translationCache.clear();
 	m_solver.reset();
 }
 
@@ -74,7 +85,11 @@ void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
+	{
+		// Cached translations might refer to the previous declaration.
+		m_translationCache.clear();
 		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
 }
@@ -84,7 +99,11 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
 	if (m_functions.count(_name))
+	{
+		// Cached translations might refer to the previous declaration.
+		m_translationCache.clear();
 		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
@@ -140,6 +159,22 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 }
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	TranslationKey key{_expr.arguments.identity(), _expr.name, _expr.sort};
+	if (auto it = m_translationCache.find(key); it != m_translationCache.end())
+		return it->second;
+
+	z3::expr result = translate(_expr);
+	if (m_translationCache.size() >= translationCacheLimit)
+		m_translationCache.clear();
+	m_translationCache.emplace(move(key), result);
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
 		return m_constants.at(_expr.name);
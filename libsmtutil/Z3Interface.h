@@ -21,6 +21,8 @@
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <tuple>
+
 namespace solidity::smtutil
 {
 
@@ -34,6 +36,8 @@ public:
 	Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	static bool available();
+	/// @returns the full version of the z3 library in use, e.g. "4.8.14.0".
+	static std::string version();
 
 	void reset() override;
 
@@ -44,15 +48,19 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override { m_context.interrupt(); }
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
-	std::map<std::string, z3::expr> constants() const { return m_constants; }
-	std::map<std::string, z3::func_decl> functions() const { return m_functions; }
+	std::map<std::string, z3::expr> const& constants() const { return m_constants; }
+	std::map<std::string, z3::func_decl> const& functions() const { return m_functions; }
 
 	z3::context* context() { return &m_context; }
 
+	/// @returns the number of compound expressions whose translation is cached.
+	size_t translationCacheSize() const { return m_translationCache.size(); }
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
@@ -60,6 +68,9 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// Translates @a _expr without looking it up in the translation cache.
+	z3::expr translate(Expression const& _expr);
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -70,6 +81,15 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+
+	/// Translations of compound expressions, keyed by the shared arguments, the operator and the sort.
+	/// Subexpressions reused by the encoding, e.g. in the accumulated path conditions,
+	/// are translated only once. The key holds on to the arguments and the sort,
+	/// so their addresses cannot be reused while they are in the cache.
+	using TranslationKey = std::tuple<std::shared_ptr<void const>, std::string, SortPointer>;
+	std::map<TranslationKey, z3::expr> m_translationCache;
+	/// Maximum number of cached translations, to bound the memory held by the cache.
+	static size_t const translationCacheLimit = 1 << 18;
 };
 
 }
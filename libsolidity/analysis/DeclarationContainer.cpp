@@ -130,6 +130,8 @@ bool DeclarationContainer::registerDeclaration(
 	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
 	if (!util::contains(decls, &_declaration))
 		decls.push_back(&_declaration);
+	if (m_similarNameIndex)
+		m_similarNameIndex->insert(*_name);
 	return true;
 }
 
@@ -152,20 +154,20 @@ vector<Declaration const*> DeclarationContainer::resolveName(
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
 
-	if (m_declarations.count(_name))
+	if (auto const* declarations = util::valueOrNullptr(m_declarations, _name))
 	{
 		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			result += *declarations | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
 		else
-			result += m_declarations.at(_name);
+			result += *declarations;
 	}
 
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
+	if (auto const* declarations = _alsoInvisible ? util::valueOrNullptr(m_invisibleDeclarations, _name) : nullptr)
 	{
 		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			result += *declarations | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
 		else
-			result += m_invisibleDeclarations.at(_name);
+			result += *declarations;
 	}
 
 	if (result.empty() && _recursive && m_enclosingContainer)
@@ -174,32 +176,74 @@ vector<Declaration const*> DeclarationContainer::resolveName(
 	return result;
 }
 
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	return {m_declarations.begin(), m_declarations.end()};
+}
+
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
 {
+	vector<ASTString> similar = similarNamesInContainer(_name);
+	if (m_enclosingContainer)
+		similar += m_enclosingContainer->similarNames(_name);
 
+	return similar;
+}
+
+vector<ASTString> DeclarationContainer::similarNamesInContainer(ASTString const& _name) const
+{
 	// because the function below has quadratic runtime - it will not magically improve once a better algorithm is discovered ;)
 	// since 80 is the suggested line length limit, we use 80^2 as length threshold
 	static size_t const MAXIMUM_LENGTH_THRESHOLD = 80 * 80;
+	// Building the index costs about as much as ten linear searches, so it only pays off
+	// for scopes that are searched repeatedly, e.g. because of several undeclared identifiers.
+	static size_t const INDEX_THRESHOLD = 8;
 
-	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
+	auto isSimilar = [&](string const& _declarationName) {
+		// The distance is at least the difference of the lengths.
+		size_t lengthDifference = max(_name.size(), _declarationName.size()) - min(_name.size(), _declarationName.size());
+		return
+			lengthDifference <= maximumEditDistance &&
+			util::stringWithinDistance(_name, _declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD);
+	};
+
+	vector<ASTString> similarVisible;
+	vector<ASTString> similarInvisible;
+	if (!m_similarNameIndex && ++m_similarNameSearches > INDEX_THRESHOLD)
 	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		m_similarNameIndex.emplace(MAXIMUM_LENGTH_THRESHOLD);
+		for (auto const& declaration: m_declarations)
+			m_similarNameIndex->insert(declaration.first);
+		for (auto const& declaration: m_invisibleDeclarations)
+			m_similarNameIndex->insert(declaration.first);
 	}
-	for (auto const& declaration: m_invisibleDeclarations)
+	if (m_similarNameIndex)
 	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		// The index yields a superset of the similar names, which may also contain removed names.
+		for (string const* declarationName: m_similarNameIndex->within(_name, maximumEditDistance))
+			if (isSimilar(*declarationName))
+			{
+				if (m_declarations.count(*declarationName))
+					similarVisible.push_back(*declarationName);
+				if (m_invisibleDeclarations.count(*declarationName))
+					similarInvisible.push_back(*declarationName);
+			}
+	}
+	else
+	{
+		for (auto const& declaration: m_declarations)
+			if (isSimilar(declaration.first))
+				similarVisible.push_back(declaration.first);
+		for (auto const& declaration: m_invisibleDeclarations)
+			if (isSimilar(declaration.first))
+				similarInvisible.push_back(declaration.first);
 	}
 
-	if (m_enclosingContainer)
-		similar += m_enclosingContainer->similarNames(_name);
-
-	return similar;
+	// Keep the order of the suggestions independent of the hash tables.
+	sort(similarVisible.begin(), similarVisible.end());
+	sort(similarInvisible.begin(), similarInvisible.end());
+	return similarVisible + similarInvisible;
 }
 
 void DeclarationContainer::populateHomonyms(back_insert_iterator<Homonyms> _it) const
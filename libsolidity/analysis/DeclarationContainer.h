@@ -26,6 +26,11 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
+#include <libsolutil/StringUtils.h>
+
+#include <map>
+#include <optional>
+#include <unordered_map>
 
 namespace solidity::frontend
 {
@@ -33,6 +38,8 @@ namespace solidity::frontend
 /**
  * Container that stores mappings between names and declarations. It also contains a link to the
  * enclosing scope.
+ * The names are stored in hash tables, since the scopes are queried far more often than they are
+ * enumerated. Scopes that are repeatedly searched for similar names index their names in a BK-tree.
  */
 class DeclarationContainer
 {
@@ -72,7 +79,8 @@ public:
 	) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations, sorted by name.
+	std::map<ASTString, std::vector<Declaration const*>> declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -94,9 +102,17 @@ public:
 private:
 	ASTNode const* m_enclosingNode = nullptr;
 	DeclarationContainer const* m_enclosingContainer = nullptr;
+	/// @returns the names in this container similar to @a _name, visible ones first and each sorted.
+	std::vector<ASTString> similarNamesInContainer(ASTString const& _name) const;
+
 	std::vector<DeclarationContainer const*> m_innerContainers;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	/// Number of calls to similarNamesInContainer() so far.
+	size_t mutable m_similarNameSearches = 0;
+	/// Index of the names of all visible and invisible declarations, created once this container
+	/// was searched for similar names repeatedly. May contain names that were removed.
+	std::optional<util::StringDistanceIndex> mutable m_similarNameIndex;
 	/// List of declarations (name and location) to check later for homonymity.
 	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
 };
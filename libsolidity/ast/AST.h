@@ -80,6 +80,9 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return int64_t(m_id); }
+	/// Adds @a _offset to the identifier of this node. Only to be used by the parser
+	/// when renumbering nodes of sources that were parsed independently.
+	void shiftID(int64_t _offset) { m_id = static_cast<size_t>(int64_t(m_id) + _offset); }
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -122,7 +125,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -69,6 +69,10 @@ void addIfSet(std::vector<pair<string, Json::Value>>& _attributes, string const&
 	_attributes.emplace_back(_name, *_value);
 }
 
+/// Key of the only member of the placeholders for deferred nodes.
+/// It cannot clash with a member of an actual AST node because of the null character.
+string const deferredNodeKey("\0node", 5);
+
 }
 
 namespace solidity::frontend
@@ -192,11 +196,66 @@ Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifie
 
 void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format)
 {
-	_stream << util::jsonPrint(toJson(_node), _format);
+	util::JsonStreamWriter writer(_stream, _format);
+	print(writer, _node);
+}
+
+void ASTJsonConverter::print(util::JsonStreamWriter& _writer, ASTNode const& _node)
+{
+	solAssert(!m_deferNodes, "");
+	m_deferNodes = true;
+	ScopeGuard resetDeferral([&]() { m_deferNodes = false; m_inEvent = false; });
+	printNode(_writer, {&_node, m_inEvent});
+}
+
+void ASTJsonConverter::printNode(util::JsonStreamWriter& _writer, DeferredNode const& _node)
+{
+	m_inEvent = _node.inEvent;
+	m_deferredNodes.clear();
+	_node.node->accept(*this);
+	Json::Value value = util::removeNullMembers(std::move(m_currentValue));
+	vector<DeferredNode> deferredNodes = std::move(m_deferredNodes);
+	printValue(_writer, value, deferredNodes);
+}
+
+void ASTJsonConverter::printValue(
+	util::JsonStreamWriter& _writer,
+	Json::Value const& _value,
+	vector<DeferredNode> const& _deferredNodes
+)
+{
+	if (_value.isObject() && _value.size() == 1 && _value.isMember(deferredNodeKey))
+		printNode(_writer, _deferredNodes.at(_value[deferredNodeKey].asLargestUInt()));
+	else if (_value.isObject() && !_value.empty())
+	{
+		_writer.beginObject();
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			_writer.key(it.name());
+			printValue(_writer, *it, _deferredNodes);
+		}
+		_writer.endObject();
+	}
+	else if (_value.isArray() && !_value.empty())
+	{
+		_writer.beginArray();
+		for (auto const& element: _value)
+			printValue(_writer, element, _deferredNodes);
+		_writer.endArray();
+	}
+	else
+		_writer.value(_value);
 }
 
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 {
+	if (m_deferNodes)
+	{
+		m_deferredNodes.push_back({&_node, m_inEvent});
+		Json::Value placeholder(Json::objectValue);
+		placeholder[deferredNodeKey] = Json::LargestUInt(m_deferredNodes.size() - 1);
+		return placeholder;
+	}
 	_node.accept(*this);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
@@ -59,7 +59,11 @@ public:
 		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
 	);
 	/// Output the json representation of the AST to _stream.
+	/// The output is identical to printing the result of toJson(), but the JSON is written
+	/// while the AST is visited, so only the nodes on the path to the current node are kept in memory.
 	void print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format);
+	/// Writes the json representation of the AST to @a _writer as the next value of the enclosing document.
+	void print(util::JsonStreamWriter& _writer, ASTNode const& _node);
 	Json::Value toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -131,6 +135,22 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// Child node whose conversion is deferred until it is written by print().
+	struct DeferredNode
+	{
+		ASTNode const* node = nullptr;
+		bool inEvent = false; ///< value of m_inEvent when the node was encountered
+	};
+
+	/// Converts @a _node and writes it to @a _writer, converting its children recursively.
+	void printNode(util::JsonStreamWriter& _writer, DeferredNode const& _node);
+	/// Writes @a _value to @a _writer, replacing placeholders by the nodes in @a _deferredNodes they refer to.
+	void printValue(
+		util::JsonStreamWriter& _writer,
+		Json::Value const& _value,
+		std::vector<DeferredNode> const& _deferredNodes
+	);
+
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
@@ -199,6 +219,9 @@ private:
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
+	/// If true, toJson() does not convert nodes but returns placeholders referring to m_deferredNodes.
+	bool m_deferNodes = false;
+	std::vector<DeferredNode> m_deferredNodes;
 };
 
 }
@@ -0,0 +1,323 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of the JSON ASTs of a set of source units.
+ */
+
+#include <libsolidity/ast/ASTSnapshot.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/Common.h>
+
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+string_view const magic("\0solast", 7);
+
+enum class Tag: uint8_t
+{
+	Null,
+	False,
+	True,
+	Int,
+	UInt,
+	Double,
+	String,
+	Array,
+	Object
+};
+
+class Encoder
+{
+public:
+	string encode(map<string, Json::Value> const& _sourceASTs)
+	{
+		string sources;
+		appendNumber(sources, _sourceASTs.size());
+		for (auto const& [sourceName, ast]: _sourceASTs)
+		{
+			string encodedAST;
+			appendValue(encodedAST, ast);
+			appendNumber(sources, stringIndex(sourceName));
+			appendNumber(sources, encodedAST.size());
+			sources += encodedAST;
+		}
+
+		string result(magic);
+		result += static_cast<char>(ASTSnapshot::version);
+		appendNumber(result, m_strings.size());
+		for (string const* str: m_strings)
+		{
+			appendNumber(result, str->size());
+			result += *str;
+		}
+		return result + sources;
+	}
+
+private:
+	static void appendNumber(string& _out, uint64_t _value)
+	{
+		for (; _value >= 0x80; _value >>= 7)
+			_out += static_cast<char>((_value & 0x7f) | 0x80);
+		_out += static_cast<char>(_value);
+	}
+
+	void appendValue(string& _out, Json::Value const& _value)
+	{
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			_out += static_cast<char>(Tag::Null);
+			break;
+		case Json::booleanValue:
+			_out += static_cast<char>(_value.asBool() ? Tag::True : Tag::False);
+			break;
+		case Json::intValue:
+		{
+			int64_t value = _value.asLargestInt();
+			_out += static_cast<char>(Tag::Int);
+			appendNumber(_out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+			break;
+		}
+		case Json::uintValue:
+			_out += static_cast<char>(Tag::UInt);
+			appendNumber(_out, _value.asLargestUInt());
+			break;
+		case Json::realValue:
+		{
+			double value = _value.asDouble();
+			uint64_t bits = 0;
+			memcpy(&bits, &value, sizeof(bits));
+			_out += static_cast<char>(Tag::Double);
+			for (size_t i = 0; i < sizeof(bits); ++i)
+				_out += static_cast<char>(bits >> (8 * i));
+			break;
+		}
+		case Json::stringValue:
+		{
+			char const* begin = nullptr;
+			char const* end = nullptr;
+			_value.getString(&begin, &end);
+			_out += static_cast<char>(Tag::String);
+			appendNumber(_out, stringIndex(string(begin, end)));
+			break;
+		}
+		case Json::arrayValue:
+			_out += static_cast<char>(Tag::Array);
+			appendNumber(_out, _value.size());
+			for (auto const& element: _value)
+				appendValue(_out, element);
+			break;
+		case Json::objectValue:
+			_out += static_cast<char>(Tag::Object);
+			appendNumber(_out, _value.size());
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				appendNumber(_out, stringIndex(it.name()));
+				appendValue(_out, *it);
+			}
+			break;
+		}
+	}
+
+	size_t stringIndex(string _string)
+	{
+		auto [it, inserted] = m_stringIndices.try_emplace(move(_string), m_strings.size());
+		if (inserted)
+			m_strings.push_back(&it->first);
+		return it->second;
+	}
+
+	unordered_map<string, size_t> m_stringIndices;
+	/// Strings in the order of their indices, pointing into m_stringIndices.
+	vector<string const*> m_strings;
+};
+
+class Decoder
+{
+public:
+	explicit Decoder(string_view _snapshot): m_data(_snapshot) {}
+
+	map<string, Json::Value> decode()
+	{
+		astAssert(ASTSnapshot::isSnapshot(m_data), "Invalid AST snapshot: Missing header.");
+		m_position = magic.size();
+		uint8_t version = readByte();
+		astAssert(
+			version == ASTSnapshot::version,
+			"AST snapshot has version " + to_string(version) + ", expected version " + to_string(ASTSnapshot::version) + "."
+		);
+
+		size_t stringCount = readSize();
+		m_strings.reserve(min(stringCount, m_data.size()));
+		for (size_t i = 0; i < stringCount; ++i)
+			m_strings.push_back(readBytes(readSize()));
+
+		map<string, Json::Value> sourceASTs;
+		size_t sourceCount = readSize();
+		for (size_t i = 0; i < sourceCount; ++i)
+		{
+			string sourceName(readString());
+			size_t end = readSize();
+			astAssert(end <= m_data.size() - m_position, "Invalid AST snapshot: Truncated source.");
+			end += m_position;
+			astAssert(!sourceASTs.count(sourceName), "Invalid AST snapshot: Duplicate source " + sourceName + ".");
+			sourceASTs[sourceName] = readValue();
+			astAssert(m_position == end, "Invalid AST snapshot: Length mismatch in source " + sourceName + ".");
+		}
+		astAssert(m_position == m_data.size(), "Invalid AST snapshot: Trailing data.");
+		return sourceASTs;
+	}
+
+private:
+	uint8_t readByte()
+	{
+		astAssert(m_position < m_data.size(), "Invalid AST snapshot: Unexpected end of data.");
+		return static_cast<uint8_t>(m_data[m_position++]);
+	}
+
+	uint64_t readNumber()
+	{
+		uint64_t value = 0;
+		for (unsigned shift = 0; ; shift += 7)
+		{
+			astAssert(shift < 64, "Invalid AST snapshot: Number too large.");
+			uint8_t byte = readByte();
+			value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return value;
+		}
+	}
+
+	size_t readSize()
+	{
+		uint64_t size = readNumber();
+		astAssert(size <= numeric_limits<size_t>::max(), "Invalid AST snapshot: Size too large.");
+		return static_cast<size_t>(size);
+	}
+
+	string_view readBytes(size_t _length)
+	{
+		astAssert(_length <= m_data.size() - m_position, "Invalid AST snapshot: Unexpected end of data.");
+		string_view bytes = m_data.substr(m_position, _length);
+		m_position += _length;
+		return bytes;
+	}
+
+	string_view readString()
+	{
+		size_t index = readSize();
+		astAssert(index < m_strings.size(), "Invalid AST snapshot: String index out of range.");
+		return m_strings[index];
+	}
+
+	Json::Value readValue()
+	{
+		// Arrays and objects are decoded recursively, so the nesting depth has to be bounded.
+		// Uses the same limit as jsonParseStrict.
+		astAssert(m_depth < maxDepth, "Invalid AST snapshot: Nesting too deep.");
+		++m_depth;
+		ScopeGuard decreaseDepth([&]() { --m_depth; });
+
+		switch (static_cast<Tag>(readByte()))
+		{
+		case Tag::Null:
+			return Json::nullValue;
+		case Tag::False:
+			return false;
+		case Tag::True:
+			return true;
+		case Tag::Int:
+		{
+			uint64_t value = readNumber();
+			return Json::LargestInt(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+		}
+		case Tag::UInt:
+			return Json::LargestUInt(readNumber());
+		case Tag::Double:
+		{
+			uint64_t bits = 0;
+			for (size_t i = 0; i < sizeof(bits); ++i)
+				bits |= static_cast<uint64_t>(readByte()) << (8 * i);
+			double value = 0;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+		case Tag::String:
+		{
+			string_view value = readString();
+			return Json::Value(value.data(), value.data() + value.size());
+		}
+		case Tag::Array:
+		{
+			Json::Value array(Json::arrayValue);
+			size_t size = readSize();
+			for (size_t i = 0; i < size; ++i)
+				array.append(readValue());
+			return array;
+		}
+		case Tag::Object:
+		{
+			Json::Value object(Json::objectValue);
+			size_t size = readSize();
+			for (size_t i = 0; i < size; ++i)
+			{
+				string_view key = readString();
+				*object.demand(key.data(), key.data() + key.size()) = readValue();
+			}
+			return object;
+		}
+		}
+		astAssert(false, "Invalid AST snapshot: Unknown value tag.");
+		return {};
+	}
+
+	static size_t constexpr maxDepth = 1000;
+
+	string_view m_data;
+	size_t m_position = 0;
+	vector<string_view> m_strings;
+	size_t m_depth = 0;
+};
+
+}
+
+bool ASTSnapshot::isSnapshot(string_view _data)
+{
+	return _data.substr(0, magic.size()) == magic;
+}
+
+string ASTSnapshot::encode(map<string, Json::Value> const& _sourceASTs)
+{
+	return Encoder{}.encode(_sourceASTs);
+}
+
+map<string, Json::Value> ASTSnapshot::decode(string_view _snapshot)
+{
+	return Decoder{_snapshot}.decode();
+}
@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of the JSON ASTs of a set of source units.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace solidity::frontend
+{
+
+/**
+ * Binary snapshot of the ASTs of a set of source units, as produced by ASTJsonConverter.
+ * Reading a snapshot is much cheaper than parsing the equivalent JSON text, because it
+ * requires no tokenization, no unescaping and stores every distinct string only once.
+ * A decoded snapshot is equal to the JSON it was created from and is imported by ASTJsonImporter.
+ *
+ * Layout (integers are unsigned LEB128 unless stated otherwise):
+ *  - the magic bytes "\0solast" followed by the format version as a single byte,
+ *  - the string table: number of strings, followed by the length and the bytes of every string,
+ *  - the number of sources, followed by, for every source, the string index of its name,
+ *    the length of the encoded AST in bytes and the encoded AST.
+ * A value is encoded as a tag byte followed by its payload:
+ *  null, false, true: no payload,
+ *  signed integer: zigzag encoded,
+ *  unsigned integer: the value,
+ *  double: eight bytes in little-endian byte order,
+ *  string: index into the string table,
+ *  array: number of elements followed by the elements,
+ *  object: number of members followed by the string index of the key and the value of every member.
+ */
+class ASTSnapshot
+{
+public:
+	static uint8_t constexpr version = 1;
+
+	/// @returns true if @a _data starts with the header of a snapshot.
+	static bool isSnapshot(std::string_view _data);
+	/// @returns the snapshot of the JSON ASTs @a _sourceASTs, indexed by source name.
+	static std::string encode(std::map<std::string, Json::Value> const& _sourceASTs);
+	/// @returns the JSON ASTs in the snapshot @a _snapshot, indexed by source name.
+	/// Throws InvalidAstError if the snapshot is malformed or was created by an incompatible version.
+	static std::map<std::string, Json::Value> decode(std::string_view _snapshot);
+};
+
+}
@@ -259,8 +259,8 @@ private:
 	/// does nothing and just returns the position again.
 	std::string arrayStoreLengthForEncodingFunction(ArrayType const& _type, EncodingOptions const& _options);
 
-	/// Helper function that uses @a _creator to create a function and add it to
-	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
+	/// Helper function that uses @a _creator to create a shared function and add it to
+	/// the function collector if it has not been created yet and returns @a _name in both
 	/// cases.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
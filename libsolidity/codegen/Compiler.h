@@ -37,10 +37,15 @@ namespace solidity::frontend
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		MultiUseYulFunctionCache* _yulFunctionCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _revertStrings),
-		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, _revertStrings, nullptr, _yulFunctionCache),
+		m_context(_evmVersion, _revertStrings, &m_runtimeContext, _yulFunctionCache)
 	{ }
 
 	/// Compiles a contract.
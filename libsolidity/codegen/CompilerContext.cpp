@@ -48,6 +48,8 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <map>
+#include <tuple>
 #include <utility>
 
 // Change to "define" to output all intermediate code
@@ -61,6 +63,24 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Key of a parsed and analysed inline assembly snippet: source text, names of the
+/// external local variables (in stack order) and the EVM version selecting the dialect.
+using InlineAssemblyCacheKey = tuple<string, vector<string>, langutil::EVMVersion>;
+
+/// Cache of parsed and analysed inline assembly snippets used by the legacy code generator.
+/// The cached code contains YulStrings, so it is cleared together with the YulStringRepository.
+map<InlineAssemblyCacheKey, pair<shared_ptr<yul::Block>, shared_ptr<yul::AsmAnalysisInfo>>>& inlineAssemblyCache()
+{
+	static map<InlineAssemblyCacheKey, pair<shared_ptr<yul::Block>, shared_ptr<yul::AsmAnalysisInfo>>> cache;
+	static yul::YulStringRepository::ResetCallback callback{[&] { cache.clear(); }};
+	return cache;
+}
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -394,6 +414,10 @@ void CompilerContext::appendInlineAssembly(
 	for (auto const& var: _localVariables)
 		externallyUsedIdentifiers.insert(yul::YulString(var));
 
+	optional<langutil::SourceLocation> locationOverride;
+	if (!_system)
+		locationOverride = m_asm->currentSourceLocation();
+
 	yul::ExternalIdentifierAccess identifierAccess;
 	identifierAccess.resolve = [&](
 		yul::Identifier const& _identifier,
@@ -421,7 +445,7 @@ void CompilerContext::appendInlineAssembly(
 		if (stackDiff < 1 || stackDiff > 16)
 			BOOST_THROW_EXCEPTION(
 				StackTooDeepError() <<
-				errinfo_sourceLocation(nativeLocationOf(_identifier)) <<
+				errinfo_sourceLocation(locationOverride ? *locationOverride : nativeLocationOf(_identifier)) <<
 				util::errinfo_comment("Stack too deep (" + to_string(stackDiff) + "), try removing local variables.")
 			);
 		if (_context == yul::IdentifierContext::RValue)
@@ -433,97 +457,110 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	langutil::CharStream charStream(_assembly, _sourceName);
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	optional<langutil::SourceLocation> locationOverride;
-	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
-	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
-		.parse(charStream);
+	bool const runOptimiser = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	// Snippets that are neither system code nor optimised only depend on their text,
+	// the names of the local variables and the dialect. Source locations are not part
+	// of the parsed code but applied during code generation via the location override.
+	bool const cacheable = !_system && !runOptimiser;
+	InlineAssemblyCacheKey cacheKey{_assembly, _localVariables, m_evmVersion};
+
+	shared_ptr<yul::Block> parserResult;
+	shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+	if (cacheable)
+		if (auto cached = inlineAssemblyCache().find(cacheKey); cached != inlineAssemblyCache().end())
+			tie(parserResult, analysisInfo) = cached->second;
+
+	if (!parserResult)
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		langutil::CharStream charStream(_assembly, _sourceName);
+		parserResult = yul::Parser(errorReporter, dialect).parse(charStream);
 #ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
 #endif
 
-	auto reportError = [&](string const& _context)
-	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n" +
-			_context + "\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			// TODO if we have "locationOverride", it will be the wrong char stream,
-			// but we do not have access to the solidity scanner.
-			message += SourceReferenceFormatter::formatErrorInformation(*error, charStream);
-		message += "-------------------------------------------\n";
-
-		solAssert(false, message);
-	};
-
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			dialect,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
-	// Several optimizer steps cannot handle externally supplied stack variables,
-	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
-	{
-		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+		auto reportError = [&](string const& _context)
+		{
+			string message =
+				"Error parsing/analyzing inline assembly block:\n" +
+				_context + "\n"
+				"------------------ Input: -----------------\n" +
+				_assembly + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: errorReporter.errors())
+				message += SourceReferenceFormatter::formatErrorInformation(*error, charStream);
+			message += "-------------------------------------------\n";
+
+			solAssert(false, message);
+		};
+
+		analysisInfo = make_shared<yul::AsmAnalysisInfo>();
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				*analysisInfo,
+				errorReporter,
+				dialect,
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		// Several optimizer steps cannot handle externally supplied stack variables,
+		// so we essentially only optimize the ABI functions.
+		if (runOptimiser)
+		{
+			yul::Object obj;
+			obj.code = parserResult;
+			obj.analysisInfo = analysisInfo;
+
+			optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+
+			if (_system)
+			{
+				// Store as generated sources, but first re-parse to update the source references.
+				solAssert(m_generatedYulUtilityCode.empty(), "");
+				m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
+				langutil::CharStream charStream(m_generatedYulUtilityCode, _sourceName);
+				obj.code = yul::Parser(errorReporter, dialect).parse(charStream);
+				*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+			}
 
-		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+			analysisInfo = std::move(obj.analysisInfo);
+			parserResult = std::move(obj.code);
 
-		if (_system)
+#ifdef SOL_OUTPUT_ASM
+			cout << "After optimizer:" << endl;
+			cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+#endif
+		}
+		else if (_system)
 		{
-			// Store as generated sources, but first re-parse to update the source references.
+			// Store as generated source.
 			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
-			string code = yul::AsmPrinter{dialect}(*obj.code);
-			langutil::CharStream charStream(m_generatedYulUtilityCode, _sourceName);
-			obj.code = yul::Parser(errorReporter, dialect).parse(charStream);
-			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+			m_generatedYulUtilityCode = _assembly;
 		}
 
-		analysisInfo = std::move(*obj.analysisInfo);
-		parserResult = std::move(obj.code);
+		if (!errorReporter.errors().empty())
+			reportError("Failed to analyze inline assembly block.");
 
-#ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer:" << endl;
-		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
-	}
-	else if (_system)
-	{
-		// Store as generated source.
-		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
-	}
+		solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
 
-	if (!errorReporter.errors().empty())
-		reportError("Failed to analyze inline assembly block.");
+		if (cacheable)
+			inlineAssemblyCache().emplace(std::move(cacheKey), make_pair(parserResult, analysisInfo));
+	}
 
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
 	yul::CodeGenerator::assemble(
 		*parserResult,
-		analysisInfo,
+		*analysisInfo,
 		*m_asm,
 		m_evmVersion,
 		identifierAccess.generateCode,
 		_system,
-		_optimiserSettings.optimizeStackAllocation
+		_optimiserSettings.optimizeStackAllocation,
+		locationOverride
 	);
 
 	// Reset the source location to the one of the node (instead of the CODEGEN source location)
@@ -63,13 +63,15 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		MultiUseYulFunctionCache* _yulFunctionCache = nullptr
 	):
 		m_asm(std::make_shared<evmasm::Assembly>(_runtimeContext != nullptr, std::string{})),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_yulFunctionCollector(_yulFunctionCache, _evmVersion, _revertStrings),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -936,14 +936,16 @@ bool ContractCompiler::visit(InlineAssembly const& _inlineAssembly)
 		_inlineAssembly.annotation().externalReferences.empty()
 	)
 	{
-		yul::EVMDialect const* dialect = dynamic_cast<decltype(dialect)>(&_inlineAssembly.dialect());
-		solAssert(dialect, "");
+		solAssert(dynamic_cast<yul::EVMDialect const*>(&_inlineAssembly.dialect()), "");
+		// The inline assembly block was analyzed for the oldest EVM version of the compilation,
+		// which can be older than the version code is generated for.
+		yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_context.evmVersion());
 
 		// Create a modifiable copy of the code and analysis
 		object.code = make_shared<yul::Block>(yul::ASTCopier().translate(*code));
-		object.analysisInfo = make_shared<yul::AsmAnalysisInfo>(yul::AsmAnalyzer::analyzeStrictAssertCorrect(*dialect, object));
+		object.analysisInfo = make_shared<yul::AsmAnalysisInfo>(yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, object));
 
-		m_context.optimizeYul(object, *dialect, m_optimiserSettings);
+		m_context.optimizeYul(object, dialect, m_optimiserSettings);
 
 		code = object.code.get();
 		analysisInfo = object.analysisInfo.get();
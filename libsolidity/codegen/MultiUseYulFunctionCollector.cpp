@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/Common.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
@@ -31,6 +32,30 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
+MultiUseYulFunctionCache::Function const* MultiUseYulFunctionCache::find(
+	string const& _settings,
+	string const& _name
+) const
+{
+	auto it = m_functions.find(key(_settings, _name));
+	return it == m_functions.end() ? nullptr : &it->second;
+}
+
+void MultiUseYulFunctionCache::insert(string const& _settings, string const& _name, Function _function)
+{
+	m_functions.emplace(key(_settings, _name), move(_function));
+}
+
+MultiUseYulFunctionCollector::MultiUseYulFunctionCollector(
+	MultiUseYulFunctionCache* _cache,
+	langutil::EVMVersion _evmVersion,
+	RevertStrings _revertStrings
+):
+	m_cache(_cache),
+	m_settings(_evmVersion.name() + "," + revertStringsToString(_revertStrings))
+{
+}
+
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
 	string result = move(m_code);
@@ -41,6 +66,7 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	solAssert(m_sharedFunctionDependencies.empty(), "Shared function depends on contract-specific function " + _name + ".");
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions.insert(_name);
@@ -58,24 +84,84 @@ string MultiUseYulFunctionCollector::createFunction(
 )
 {
 	solAssert(!_name.empty(), "");
+	solAssert(m_sharedFunctionDependencies.empty(), "Shared function depends on contract-specific function " + _name + ".");
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions.insert(_name);
-		vector<string> arguments;
-		vector<string> returnParameters;
-		string body = _creator(arguments, returnParameters);
-		solAssert(!body.empty(), "");
-
-		m_code += Whiskers(R"(
-			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
-				<body>
-			}
-		)")
-		("functionName", _name)
-		("args", joinHumanReadable(arguments))
-		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
-		.render();
+		m_code += functionCode(_name, _creator);
 	}
 	return _name;
 }
+
+string MultiUseYulFunctionCollector::createSharedFunction(string const& _name, function<string()> const& _creator)
+{
+	if (!m_sharedFunctionDependencies.empty())
+		m_sharedFunctionDependencies.back().push_back(_name);
+	if (m_requestedFunctions.count(_name))
+		return _name;
+
+	if (m_cache)
+		if (MultiUseYulFunctionCache::Function const* cached = m_cache->find(m_settings, _name))
+		{
+			addCachedFunction(_name, *cached);
+			return _name;
+		}
+
+	m_requestedFunctions.insert(_name);
+	m_sharedFunctionDependencies.emplace_back();
+	ScopeGuard popDependencies([&]{ m_sharedFunctionDependencies.pop_back(); });
+	string fun = _creator();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+	if (m_cache)
+		m_cache->insert(m_settings, _name, {fun, move(m_sharedFunctionDependencies.back())});
+	m_code += move(fun);
+	return _name;
+}
+
+string MultiUseYulFunctionCollector::createSharedFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	solAssert(!_name.empty(), "");
+	return createSharedFunction(_name, [&]() { return functionCode(_name, _creator); });
+}
+
+string MultiUseYulFunctionCollector::functionCode(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	vector<string> arguments;
+	vector<string> returnParameters;
+	string body = _creator(arguments, returnParameters);
+	solAssert(!body.empty(), "");
+
+	return Whiskers(R"(
+		function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
+			<body>
+		}
+	)")
+	("functionName", _name)
+	("args", joinHumanReadable(arguments))
+	("retParams", joinHumanReadable(returnParameters))
+	("body", body)
+	.render();
+}
+
+void MultiUseYulFunctionCollector::addCachedFunction(
+	string const& _name,
+	MultiUseYulFunctionCache::Function const& _function
+)
+{
+	m_requestedFunctions.insert(_name);
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			MultiUseYulFunctionCache::Function const* cached = m_cache->find(m_settings, dependency);
+			solAssert(cached, "Dependency " + dependency + " of cached function " + _name + " not found.");
+			addCachedFunction(dependency, *cached);
+		}
+	m_code += _function.code;
+}
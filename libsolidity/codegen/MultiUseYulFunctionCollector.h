@@ -22,14 +22,53 @@
 
 #pragma once
 
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolidity/interface/DebugSettings.h>
+
 #include <functional>
 #include <map>
 #include <string>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Code of shared Yul functions, i.e. functions whose code only depends on their name and the
+ * code generation settings, generated for any of the contracts of a compilation.
+ * Lets the MultiUseYulFunctionCollector of every contract reuse the helper functions of
+ * ABIFunctions and YulUtilFunctions instead of generating them again.
+ * Not thread-safe, contracts have to be generated one after another.
+ */
+class MultiUseYulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the shared functions requested while generating the code, in the order of
+		/// the requests, including the ones that had already been generated at that point.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the function @a _name generated with the settings @a _settings or nullptr if
+	/// it has not been generated yet.
+	Function const* find(std::string const& _settings, std::string const& _name) const;
+	void insert(std::string const& _settings, std::string const& _name, Function _function);
+	void clear() { m_functions.clear(); }
+
+	/// @returns the number of functions in the cache.
+	size_t size() const { return m_functions.size(); }
+
+private:
+	static std::string key(std::string const& _settings, std::string const& _name) { return _settings + ":" + _name; }
+
+	std::unordered_map<std::string, Function> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -37,6 +76,15 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	MultiUseYulFunctionCollector() = default;
+	/// Creates a collector that takes the code of shared functions from @a _cache if they were
+	/// generated with the same settings before and adds the ones it generates to it.
+	MultiUseYulFunctionCollector(
+		MultiUseYulFunctionCache* _cache,
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings
+	);
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -47,6 +95,17 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Like createFunction, but for functions whose code only depends on @a _name and the
+	/// settings of the collector (but not on the contract), like the helpers of ABIFunctions
+	/// and YulUtilFunctions. Their code is taken from the cache if it is present there.
+	/// @a _creator may only request other shared functions.
+	std::string createSharedFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	std::string createSharedFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions in the order in which they were
 	/// generated.
 	/// Clears the internal list, i.e. calling it again will result in an
@@ -57,8 +116,21 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	/// @returns the code of the function @a _name with the parameters and the body created by @a _creator.
+	static std::string functionCode(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+	/// Adds the cached function @a _name and, before it, the dependencies that are still missing,
+	/// in the order in which generating it would add them.
+	void addCachedFunction(std::string const& _name, MultiUseYulFunctionCache::Function const& _function);
+
 	std::set<std::string> m_requestedFunctions;
 	std::string m_code;
+	MultiUseYulFunctionCache* m_cache = nullptr;
+	std::string m_settings;
+	/// Dependencies of the shared functions currently being generated, innermost last.
+	std::vector<std::vector<std::string>> m_sharedFunctionDependencies;
 };
 
 }
@@ -39,7 +39,7 @@ using namespace solidity::frontend;
 string YulUtilFunctions::identityFunction()
 {
 	string functionName = "identity";
-	return m_functionCollector.createFunction("identity", [&](vector<string>& _args, vector<string>& _rets) {
+	return m_functionCollector.createSharedFunction("identity", [&](vector<string>& _args, vector<string>& _rets) {
 		_args.push_back("value");
 		_rets.push_back("ret");
 		return "ret := value";
@@ -49,7 +49,7 @@ string YulUtilFunctions::identityFunction()
 string YulUtilFunctions::combineExternalFunctionIdFunction()
 {
 	string functionName = "combine_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(addr, selector) -> combined {
 				combined := <shl64>(or(<shl32>(addr), and(selector, 0xffffffff)))
@@ -65,7 +65,7 @@ string YulUtilFunctions::combineExternalFunctionIdFunction()
 string YulUtilFunctions::splitExternalFunctionIdFunction()
 {
 	string functionName = "split_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(combined) -> addr, selector {
 				combined := <shr64>(combined)
@@ -83,7 +83,7 @@ string YulUtilFunctions::splitExternalFunctionIdFunction()
 string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 {
 	string functionName = "copy_" + string(_fromCalldata ? "calldata" : "memory") + "_to_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_fromCalldata)
 		{
 			return Whiskers(R"(
@@ -122,7 +122,7 @@ string YulUtilFunctions::copyLiteralToMemoryFunction(string const& _literal)
 {
 	string functionName = "copy_literal_to_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := <arrayAllocationFunction>(<size>)
@@ -141,7 +141,7 @@ string YulUtilFunctions::storeLiteralInMemoryFunction(string const& _literal)
 {
 	string functionName = "store_literal_in_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		size_t words = (_literal.length() + 31) / 32;
 		vector<map<string, string>> wordParams(words);
 		for (size_t i = 0; i < words; ++i)
@@ -167,7 +167,7 @@ string YulUtilFunctions::copyLiteralToStorageFunction(string const& _literal)
 {
 	string functionName = "copy_literal_to_storage_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"slot"};
 
 		if (_literal.size() >= 32)
@@ -219,7 +219,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 
 	solAssert(!_assert || !_messageType, "Asserts can't have messages!");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (!_messageType)
 			return Whiskers(R"(
 				function <functionName>(condition) {
@@ -265,7 +265,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 string YulUtilFunctions::leftAlignFunction(Type const& _type)
 {
 	string functionName = string("leftAlign_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> aligned {
 				<body>
@@ -327,7 +327,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 	solAssert(_numBits < 256, "");
 
 	string functionName = "shift_left_" + to_string(_numBits);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -350,7 +350,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 string YulUtilFunctions::shiftLeftFunctionDynamic()
 {
 	string functionName = "shift_left_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -376,7 +376,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 	// the opcodes SAR and SDIV behave differently with regards to rounding!
 
 	string functionName = "shift_right_" + to_string(_numBits) + "_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -399,7 +399,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 string YulUtilFunctions::shiftRightFunctionDynamic()
 {
 	string const functionName = "shift_right_unsigned_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -420,7 +420,7 @@ string YulUtilFunctions::shiftRightFunctionDynamic()
 string YulUtilFunctions::shiftRightSignedFunctionDynamic()
 {
 	string const functionName = "shift_right_signed_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> result {
@@ -451,7 +451,7 @@ string YulUtilFunctions::typedShiftLeftFunction(Type const& _type, Type const& _
 	solAssert(_amountType.category() == Type::Category::Integer, "");
 	solAssert(!dynamic_cast<IntegerType const&>(_amountType).isSigned(), "");
 	string const functionName = "shift_left_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -477,7 +477,7 @@ string YulUtilFunctions::typedShiftRightFunction(Type const& _type, Type const&
 	bool valueSigned = integerType && integerType->isSigned();
 
 	string const functionName = "shift_right_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -500,7 +500,7 @@ string YulUtilFunctions::updateByteSliceFunction(size_t _numBytes, size_t _shift
 	size_t numBits = _numBytes * 8;
 	size_t shiftBits = _shiftBytes * 8;
 	string functionName = "update_byte_slice_" + to_string(_numBytes) + "_shift_" + to_string(_shiftBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, toInsert) -> result {
@@ -522,7 +522,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 	solAssert(_numBytes <= 32, "");
 	size_t numBits = _numBytes * 8;
 	string functionName = "update_byte_slice_dynamic" + to_string(_numBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, shiftBytes, toInsert) -> result {
@@ -543,7 +543,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 string YulUtilFunctions::maskBytesFunctionDynamic()
 {
 	string functionName = "mask_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shr>(mul(8, bytes), not(0)))
@@ -559,7 +559,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 {
 	string functionName = "mask_lower_order_bytes_" + to_string(_bytes);
 	solAssert(_bytes <= 32, "");
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data) -> result {
 				result := and(data, <mask>)
@@ -573,7 +573,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 {
 	string functionName = "mask_lower_order_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shl>(mul(8, bytes), not(0)))
@@ -588,7 +588,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 string YulUtilFunctions::roundUpFunction()
 {
 	string functionName = "round_up_to_mul_of_32";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> result {
@@ -602,7 +602,7 @@ string YulUtilFunctions::roundUpFunction()
 
 string YulUtilFunctions::divide32CeilFunction()
 {
-	return m_functionCollector.createFunction(
+	return m_functionCollector.createSharedFunction(
 		"divide_by_32_ceil",
 		[&](vector<string>& _args, vector<string>& _ret) {
 			_args = {"value"};
@@ -618,7 +618,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 	// TODO: Consider to add a special case for unsigned 256-bit integers
 	//       and use the following instead:
 	//       sum := add(x, y) if lt(sum, x) { <panic>() }
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -649,7 +649,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_add_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -665,7 +665,7 @@ string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "checked_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			// Multiplication by zero could be treated separately and directly return zero.
 			Whiskers(R"(
@@ -701,7 +701,7 @@ string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> product {
@@ -717,7 +717,7 @@ string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "checked_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -747,7 +747,7 @@ string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -768,7 +768,7 @@ string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::intModFunction(IntegerType const& _type)
 {
 	string functionName = "mod_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -789,7 +789,7 @@ string YulUtilFunctions::intModFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "checked_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -819,7 +819,7 @@ string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -840,7 +840,7 @@ string YulUtilFunctions::overflowCheckedIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "checked_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -877,7 +877,7 @@ string YulUtilFunctions::overflowCheckedIntLiteralExpFunction(
 
 	string functionName = "checked_exp_" + _baseType.richIdentifier() + "_" + _exponentType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]()
+	return m_functionCollector.createSharedFunction(functionName, [&]()
 	{
 		// Converts a bigint number into u256 (negative numbers represented in two's complement form.)
 		// We assume that `_v` fits in 256 bits.
@@ -991,7 +991,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 	solAssert(pow(bigint(306), 32) >= pow(bigint(2), 256), "");
 
 	string functionName = "checked_exp_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, max) -> power {
@@ -1039,7 +1039,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 string YulUtilFunctions::overflowCheckedSignedExpFunction()
 {
 	string functionName = "checked_exp_signed";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, min, max) -> power {
@@ -1095,7 +1095,7 @@ string YulUtilFunctions::overflowCheckedExpLoopFunction()
 	// This function does not include the final multiplication.
 
 	string functionName = "checked_exp_helper";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(_power, _base, exponent, max) -> power, base {
@@ -1134,7 +1134,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "wrapping_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -1153,7 +1153,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 {
 	string functionName = "array_length_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(value<?dynamic><?calldata>, len</calldata></dynamic>) -> length {
 				<?dynamic>
@@ -1195,7 +1195,7 @@ string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 string YulUtilFunctions::extractByteArrayLengthFunction()
 {
 	string functionName = "extract_byte_array_length";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(data) -> length {
 				length := div(data, 2)
@@ -1224,7 +1224,7 @@ std::string YulUtilFunctions::resizeArrayFunction(ArrayType const& _type)
 		return resizeDynamicByteArrayFunction(_type);
 
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(array, newLen) {
 				if gt(newLen, <maxArrayLength>) {
@@ -1263,7 +1263,7 @@ string YulUtilFunctions::cleanUpStorageArrayEndFunction(ArrayType const& _type)
 	solUnimplementedAssert(_type.baseType()->storageBytes() <= 32);
 
 	string functionName = "cleanup_storage_array_end_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "len", "startIndex"};
 		return Whiskers(R"(
 			if lt(startIndex, len) {
@@ -1296,7 +1296,7 @@ string YulUtilFunctions::cleanUpStorageArrayEndFunction(ArrayType const& _type)
 string YulUtilFunctions::resizeDynamicByteArrayFunction(ArrayType const& _type)
 {
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "newLen"};
 		return Whiskers(R"(
 			let data := sload(array)
@@ -1323,7 +1323,7 @@ string YulUtilFunctions::cleanUpDynamicByteArrayEndSlotsFunction(ArrayType const
 	solAssert(_type.isDynamicallySized(), "");
 
 	string functionName = "clean_up_bytearray_end_slots_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "len", "startIndex"};
 		return Whiskers(R"(
 			if gt(len, 31) {
@@ -1344,7 +1344,7 @@ string YulUtilFunctions::cleanUpDynamicByteArrayEndSlotsFunction(ArrayType const
 string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_decrease_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, data, oldLen, newLen) {
 				switch lt(newLen, 32)
@@ -1387,7 +1387,7 @@ string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_increase_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "data", "oldLen", "newLen"};
 		return Whiskers(R"(
 			if gt(newLen, <maxArrayLength>) { <panic>() }
@@ -1422,7 +1422,7 @@ string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _type)
 {
 	string functionName = "transit_byte_array_long_to_short_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, len) {
 				// we need to copy elements from old array to new
@@ -1442,7 +1442,7 @@ string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _t
 string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 {
 	string functionName = "extract_used_part_and_set_length_of_short_byte_array";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, len) -> used {
 				// we want to save only elements that are part of the array after resizing
@@ -1458,7 +1458,7 @@ string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 
 string YulUtilFunctions::longByteArrayStorageIndexAccessNoCheckFunction()
 {
-	return m_functionCollector.createFunction(
+	return m_functionCollector.createSharedFunction(
 		"long_byte_array_index_access_no_checks",
 		[&](vector<string>& _args, vector<string>& _returnParams) {
 			_args = {"array", "index"};
@@ -1483,7 +1483,7 @@ string YulUtilFunctions::storageArrayPopFunction(ArrayType const& _type)
 		return storageByteArrayPopFunction(_type);
 
 	string functionName = "array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let oldLen := <fetchLength>(array)
@@ -1512,7 +1512,7 @@ string YulUtilFunctions::storageByteArrayPopFunction(ArrayType const& _type)
 	solAssert(_type.isByteArrayOrString(), "");
 
 	string functionName = "byte_array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let data := sload(array)
@@ -1563,7 +1563,7 @@ string YulUtilFunctions::storageArrayPushFunction(ArrayType const& _type, Type c
 		_fromType->identifier() +
 		"_to_" +
 		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array <values>) {
 				<?isByteArrayOrString>
@@ -1627,7 +1627,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 	solUnimplementedAssert(_type.baseType()->storageBytes() <= 32, "Base type is not yet implemented.");
 
 	string functionName = "array_push_zero_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) -> slot, offset {
 				<?isBytes>
@@ -1656,7 +1656,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 string YulUtilFunctions::partialClearStorageSlotFunction()
 {
 	string functionName = "partial_clear_storage_slot";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 		function <functionName>(slot, offset) {
 			let mask := <shr>(mul(8, sub(32, offset)), <ones>)
@@ -1677,7 +1677,7 @@ string YulUtilFunctions::clearStorageRangeFunction(Type const& _type)
 
 	string functionName = "clear_storage_range_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(start, end) {
 				for {} lt(start, end) { start := add(start, <increment>) }
@@ -1708,7 +1708,7 @@ string YulUtilFunctions::clearStorageArrayFunction(ArrayType const& _type)
 
 	string functionName = "clear_storage_array_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(slot) {
 				<?dynamic>
@@ -1739,7 +1739,7 @@ string YulUtilFunctions::clearStorageStructFunction(StructType const& _type)
 
 	string functionName = "clear_struct_storage_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		MemberList::MemberMap structMembers = _type.nativeMembers(nullptr);
 		vector<map<string, string>> memberSetValues;
 
@@ -1801,7 +1801,7 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 		return copyValueArrayStorageToStorageFunction(_fromType, _toType);
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>) {
 				<?fromStorage> if eq(slot, value) { leave } </fromStorage>
@@ -1906,7 +1906,7 @@ string YulUtilFunctions::copyByteArrayToStorageFunction(ArrayType const& _fromTy
 	solAssert(_toType.isByteArrayOrString(), "");
 
 	string functionName = "copy_byte_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, src<?fromCalldata>, len</fromCalldata>) {
 				<?fromStorage> if eq(slot, src) { leave } </fromStorage>
@@ -1989,7 +1989,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 	solAssert(_toType.storageStride() <= 32, "");
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(dst, src) {
 				if eq(dst, src) { leave }
@@ -2115,7 +2115,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 string YulUtilFunctions::arrayConvertLengthToSize(ArrayType const& _type)
 {
 	string functionName = "array_convert_length_to_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Type const& baseType = *_type.baseType();
 
 		switch (_type.location())
@@ -2169,7 +2169,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 {
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 	string functionName = "array_allocation_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(length) -> size {
 				// Make sure we can allocate memory without overflow
@@ -2197,7 +2197,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 {
 	string functionName = "array_dataslot_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		// No special processing for calldata arrays, because they are stored as
 		// offset of the data area and length on the stack, so the offset already
 		// points to the data area.
@@ -2228,7 +2228,7 @@ string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "storage_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, index) -> slot, offset {
 				let arrayLength := <arrayLen>(array)
@@ -2273,7 +2273,7 @@ string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 string YulUtilFunctions::memoryArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "memory_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(baseRef, index) -> addr {
 				if iszero(lt(index, <arrayLen>(baseRef))) {
@@ -2300,7 +2300,7 @@ string YulUtilFunctions::calldataArrayIndexAccessFunction(ArrayType const& _type
 {
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "calldata_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref<?dynamicallySized>, length</dynamicallySized>, index) -> addr<?dynamicallySizedBase>, len</dynamicallySizedBase> {
 				if iszero(lt(index, <?dynamicallySized>length<!dynamicallySized><arrayLen></dynamicallySized>)) { <panic>() }
@@ -2327,7 +2327,7 @@ string YulUtilFunctions::calldataArrayIndexRangeAccess(ArrayType const& _type)
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	solAssert(_type.isDynamicallySized(), "");
 	string functionName = "calldata_array_index_range_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(offset, length, startIndex, endIndex) -> offsetOut, lengthOut {
 				if gt(startIndex, endIndex) { <revertSliceStartAfterEnd>() }
@@ -2349,7 +2349,7 @@ string YulUtilFunctions::accessCalldataTailFunction(Type const& _type)
 	solAssert(_type.isDynamicallyEncoded(), "");
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "access_calldata_tail_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref, ptr_to_tail) -> addr<?dynamicallySized>, length</dynamicallySized> {
 				let rel_offset_of_tail := calldataload(ptr_to_tail)
@@ -2380,7 +2380,7 @@ string YulUtilFunctions::nextArrayElementFunction(ArrayType const& _type)
 	if (_type.dataStoredIn(DataLocation::Storage))
 		solAssert(_type.baseType()->storageBytes() > 16, "");
 	string functionName = "array_nextElement_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(ptr) -> next {
 				next := add(ptr, <advance>)
@@ -2421,7 +2421,7 @@ string YulUtilFunctions::copyArrayFromStorageToMemoryFunction(ArrayType const& _
 
 	string functionName = "copy_array_from_storage_to_memory_" + _from.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_from.baseType()->isValueType())
 		{
 			solAssert(*_from.baseType() == *_to.baseType(), "");
@@ -2514,7 +2514,7 @@ string YulUtilFunctions::bytesOrStringConcatFunction(
 		totalParams += argumentType->sizeOnStack();
 		functionName += "_" + argumentType->identifier();
 	}
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(<parameters>) -> outPtr {
 				outPtr := <allocateUnbounded>()
@@ -2542,7 +2542,7 @@ string YulUtilFunctions::bytesOrStringConcatFunction(
 string YulUtilFunctions::mappingIndexAccessFunction(MappingType const& _mappingType, Type const& _keyType)
 {
 	string functionName = "mapping_index_access_" + _mappingType.identifier() + "_of_" + _keyType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_mappingType.keyType()->isDynamicallySized())
 			return Whiskers(R"(
 				function <functionName>(slot <?+key>,</+key> <key>) -> dataSlot {
@@ -2599,7 +2599,7 @@ string YulUtilFunctions::readFromStorageDynamic(Type const& _type, bool _splitFu
 		string(_splitFunctionTypes ? "split_" : "") +
 		_type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot, offset) -> value {
 				if gt(offset, 0) { <panic>() }
@@ -2627,7 +2627,7 @@ string YulUtilFunctions::readFromStorageValueType(Type const& _type, optional<si
 			"_" +
 			_type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(slot<?dynamic>, offset</dynamic>) -> <?split>addr, selector<!split>value</split> {
 				<?split>let</split> value := <extract>(sload(slot)<?dynamic>, offset</dynamic>)
@@ -2688,7 +2688,7 @@ string YulUtilFunctions::readFromStorageReferenceType(Type const& _type)
 		.render();
 	}
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot) -> value {
 				value := <allocStruct>()
@@ -2727,7 +2727,7 @@ string YulUtilFunctions::updateStorageValueFunction(
 		"_to_" +
 		_toType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		if (_toType.isValueType())
 		{
 			solAssert(_fromType.isImplicitlyConvertibleTo(_toType), "");
@@ -2830,7 +2830,7 @@ string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 {
 	string const functionName = "write_to_memory_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		solAssert(!dynamic_cast<StringLiteralType const*>(&_type), "");
 		if (auto ref = dynamic_cast<ReferenceType const*>(&_type))
 		{
@@ -2887,7 +2887,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 	string functionName =
 		"extract_from_storage_value_dynamic" +
 		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value, offset) -> value {
 				value := <cleanupStorage>(<shr>(mul(offset, 8), slot_value))
@@ -2903,7 +2903,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 string YulUtilFunctions::extractFromStorageValue(Type const& _type, size_t _offset)
 {
 	string functionName = "extract_from_storage_value_offset_" + to_string(_offset) + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value) -> value {
 				value := <cleanupStorage>(<shr>(slot_value))
@@ -2921,7 +2921,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 	solAssert(_type.isValueType(), "");
 
 	string functionName = string("cleanup_from_storage_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				cleaned := <cleaned>
@@ -2954,7 +2954,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 {
 	string functionName = "prepare_store_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		solAssert(_type.isValueType(), "");
 		auto const* funType = dynamic_cast<FunctionType const*>(&_type);
 		if (funType && funType->kind() == FunctionType::Kind::External)
@@ -2990,7 +2990,7 @@ string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 string YulUtilFunctions::allocationFunction()
 {
 	string functionName = "allocate_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(size) -> memPtr {
 				memPtr := <allocateUnbounded>()
@@ -3007,7 +3007,7 @@ string YulUtilFunctions::allocationFunction()
 string YulUtilFunctions::allocateUnboundedFunction()
 {
 	string functionName = "allocate_unbounded";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := mload(<freeMemoryPointer>)
@@ -3022,7 +3022,7 @@ string YulUtilFunctions::allocateUnboundedFunction()
 string YulUtilFunctions::finalizeAllocationFunction()
 {
 	string functionName = "finalize_allocation";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(memPtr, size) {
 				let newFreePtr := add(memPtr, <roundUp>(size))
@@ -3051,7 +3051,7 @@ string YulUtilFunctions::zeroMemoryFunction(Type const& _type)
 	solAssert(_type.hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_memory_chunk_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
 				calldatacopy(dataStart, calldatasize(), dataSizeInBytes)
@@ -3067,7 +3067,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 	solAssert(!_type.baseType()->hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_complex_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		solAssert(_type.memoryStride() == 32, "");
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
@@ -3086,7 +3086,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					let allocSize := <allocSize>(length)
@@ -3107,7 +3107,7 @@ string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					memPtr := <allocArray>(length)
@@ -3132,7 +3132,7 @@ string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType cons
 string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <alloc>(<allocSize>)
@@ -3149,7 +3149,7 @@ string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <allocStruct>()
@@ -3208,7 +3208,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return m_functionCollector.createSharedFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(<?external>addr, </external>functionId) -> <?external>outAddr, </external>outFunctionId {
 					<?external>outAddr := addr</external>
@@ -3249,7 +3249,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return m_functionCollector.createSharedFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(offset, length) -> outOffset, outLength {
 					outOffset := offset
@@ -3280,7 +3280,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 		_from.identifier() +
 		"_to_" +
 		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> converted {
 				<body>
@@ -3472,7 +3472,7 @@ string YulUtilFunctions::bytesToFixedBytesConversionFunction(ArrayType const& _f
 	solAssert(_from.isByteArray(), "");
 	solAssert(_from.isDynamicallySized(), "");
 	string functionName = "convert_bytes_to_fixedbytes_from_" + _from.identifier() + "_to_" + _to.identifier();
-	return m_functionCollector.createFunction(functionName, [&](auto& _args, auto& _returnParams) {
+	return m_functionCollector.createSharedFunction(functionName, [&](auto& _args, auto& _returnParams) {
 		_args = { "array" };
 		bool fromCalldata = _from.dataStoredIn(DataLocation::CallData);
 		if (fromCalldata)
@@ -3536,7 +3536,7 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 		"_to_" +
 		_to.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&](auto& _arguments, auto&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](auto& _arguments, auto&) {
 		_arguments = {"slot", "value"};
 		Whiskers templ(R"(
 			<?fromStorage> if iszero(eq(slot, value)) { </fromStorage>
@@ -3660,7 +3660,7 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 		"_to_" +
 		_to.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value<?fromCalldataDynamic>, length</fromCalldataDynamic>) -> converted <?toCalldataDynamic>, outLength</toCalldataDynamic> {
 				<body>
@@ -3726,7 +3726,7 @@ string YulUtilFunctions::cleanupFunction(Type const& _type)
 		return cleanupFunction(userDefinedValueType->underlyingType());
 
 	string functionName = string("cleanup_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				<body>
@@ -3823,7 +3823,7 @@ string YulUtilFunctions::cleanupFunction(Type const& _type)
 string YulUtilFunctions::validatorFunction(Type const& _type, bool _revertOnFailure)
 {
 	string functionName = string("validator_") + (_revertOnFailure ? "revert_" : "assert_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) {
 				if iszero(<condition>) { <failure> }
@@ -3888,7 +3888,7 @@ string YulUtilFunctions::packedHashFunction(
 	size_t sizeOnStack = 0;
 	for (Type const* t: _givenTypes)
 		sizeOnStack += t->sizeOnStack();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(<variables>) -> hash {
 				let pos := <allocateUnbounded>()
@@ -3909,7 +3909,7 @@ string YulUtilFunctions::forwardingRevertFunction()
 {
 	bool forward = m_evmVersion.supportsReturndata();
 	string functionName = "revert_forward_" + to_string(forward);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (forward)
 			return Whiskers(R"(
 				function <functionName>() {
@@ -3939,7 +3939,7 @@ std::string YulUtilFunctions::decrementCheckedFunction(Type const& _type)
 
 	string const functionName = "decrement_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3962,7 +3962,7 @@ std::string YulUtilFunctions::decrementWrappingFunction(Type const& _type)
 
 	string const functionName = "decrement_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(value, 1))
@@ -3981,7 +3981,7 @@ std::string YulUtilFunctions::incrementCheckedFunction(Type const& _type)
 
 	string const functionName = "increment_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -4004,7 +4004,7 @@ std::string YulUtilFunctions::incrementWrappingFunction(Type const& _type)
 
 	string const functionName = "increment_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(add(value, 1))
@@ -4023,7 +4023,7 @@ string YulUtilFunctions::negateNumberCheckedFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -4046,7 +4046,7 @@ string YulUtilFunctions::negateNumberWrappingFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_wrapping_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(0, value))
@@ -4064,7 +4064,7 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 
 	string const functionName = "zero_value_for_" + string(_splitFunctionTypes ? "split_" : "") + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		FunctionType const* fType = dynamic_cast<FunctionType const*>(&_type);
 		if (fType && fType->kind() == FunctionType::Kind::External && _splitFunctionTypes)
 			return Whiskers(R"(
@@ -4137,7 +4137,7 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 {
 	string const functionName = "storage_set_to_zero_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_type.isValueType())
 			return Whiskers(R"(
 				function <functionName>(slot, offset) {
@@ -4184,7 +4184,7 @@ string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const
 		_from.identifier() +
 		"_to_" +
 		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (
 			auto fromTuple = dynamic_cast<TupleType const*>(&_from), toTuple = dynamic_cast<TupleType const*>(&_to);
 			fromTuple && toTuple && fromTuple->components().size() == toTuple->components().size()
@@ -4276,7 +4276,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 	if (_fromCalldata)
 		solAssert(!_type.isDynamicallyEncoded(), "");
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
 		{
 			solAssert(refType->sizeOnStack() == 1, "");
@@ -4336,7 +4336,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 string YulUtilFunctions::revertReasonIfDebugFunction(string const& _message)
 {
 	string functionName = "revert_error_" + util::toHex(util::keccak256(_message).asBytes());
-	return m_functionCollector.createFunction(functionName, [&](auto&, auto&) -> string {
+	return m_functionCollector.createSharedFunction(functionName, [&](auto&, auto&) -> string {
 		return revertReasonIfDebugBody(m_revertStrings, allocateUnboundedFunction() + "()", _message);
 	});
 }
@@ -4384,7 +4384,7 @@ string YulUtilFunctions::revertReasonIfDebugBody(
 string YulUtilFunctions::panicFunction(util::PanicCode _code)
 {
 	string functionName = "panic_error_" + toCompactHexWithPrefix(uint64_t(_code));
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() {
 				mstore(0, <selector>)
@@ -4404,7 +4404,7 @@ string YulUtilFunctions::returnDataSelectorFunction()
 	string const functionName = "return_data_selector";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> sig {
 				if gt(returndatasize(), 3) {
@@ -4424,7 +4424,7 @@ string YulUtilFunctions::tryDecodeErrorMessageFunction()
 	string const functionName = "try_decode_error_message";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> ret {
 				if lt(returndatasize(), 0x44) { leave }
@@ -4463,7 +4463,7 @@ string YulUtilFunctions::tryDecodePanicDataFunction()
 	string const functionName = "try_decode_panic_data";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> success, data {
 				if gt(returndatasize(), 0x23) {
@@ -4482,7 +4482,7 @@ string YulUtilFunctions::extractReturndataFunction()
 {
 	string const functionName = "extract_returndata";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> data {
 				<?supportsReturndata>
@@ -4519,7 +4519,7 @@ string YulUtilFunctions::copyConstructorArgumentsToMemoryFunction(
 		"_" +
 		toString(_contract.id());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		string returnParams = suffixedVariableNameList("ret_param_",0, CompilerUtils::sizeOnStack(_contract.constructor()->parameters()));
 		ABIFunctions abiFunctions(m_evmVersion, m_revertStrings, m_functionCollector);
 
@@ -4547,7 +4547,7 @@ string YulUtilFunctions::externalCodeFunction()
 {
 	string functionName = "external_code_at";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>(addr) -> mpos {
 				let length := extcodesize(addr)
@@ -4564,7 +4564,7 @@ string YulUtilFunctions::externalCodeFunction()
 std::string YulUtilFunctions::externalFunctionPointersEqualFunction()
 {
 	std::string const functionName = "externalFunctionPointersEqualFunction";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>(
 				leftAddress,
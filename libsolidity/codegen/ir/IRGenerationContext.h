@@ -76,18 +76,23 @@ public:
 		OptimiserSettings _optimiserSettings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
-		langutil::CharStreamProvider const* _soliditySourceProvider
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		MultiUseYulFunctionCache* _yulFunctionCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_executionContext(_executionContext),
 		m_revertStrings(_revertStrings),
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_sourceIndices(std::move(_sourceIndices)),
+		m_functions(_yulFunctionCache, _evmVersion, _revertStrings),
 		m_debugInfoSelection(_debugInfoSelection),
-		m_soliditySourceProvider(_soliditySourceProvider)
+		m_soliditySourceProvider(_soliditySourceProvider),
+		m_yulFunctionCache(_yulFunctionCache)
 	{}
 
 	MultiUseYulFunctionCollector& functionCollector() { return m_functions; }
+	/// @returns the cache of shared Yul functions of the compilation, if any.
+	MultiUseYulFunctionCache* yulFunctionCache() const { return m_yulFunctionCache; }
 
 	/// Adds a Solidity function to the function generation queue and returns the name of the
 	/// corresponding Yul function.
@@ -226,6 +231,7 @@ private:
 
 	langutil::DebugInfoSelection m_debugInfoSelection = {};
 	langutil::CharStreamProvider const* m_soliditySourceProvider = nullptr;
+	MultiUseYulFunctionCache* m_yulFunctionCache = nullptr;
 };
 
 }
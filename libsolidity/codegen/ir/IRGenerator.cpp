@@ -31,7 +31,6 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libyul/YulStack.h>
-#include <libyul/Utilities.h>
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/CommonData.h>
@@ -93,7 +92,7 @@ pair<string, string> IRGenerator::run(
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
 {
-	string ir = yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+	string ir = generate(_contract, _cborMetadata, _otherYulSources);
 
 	yul::YulStack asmStack(
 		m_evmVersion,
@@ -1114,7 +1113,8 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 		m_optimiserSettings,
 		m_context.sourceIndices(),
 		m_context.debugInfoSelection(),
-		m_context.soliditySourceProvider()
+		m_context.soliditySourceProvider(),
+		m_context.yulFunctionCache()
 	);
 	newContext.copyFunctionIDsFrom(m_context);
 	m_context = move(newContext);
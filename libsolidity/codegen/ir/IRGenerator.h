@@ -50,7 +50,8 @@ public:
 		OptimiserSettings _optimiserSettings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
-		langutil::CharStreamProvider const* _soliditySourceProvider
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		MultiUseYulFunctionCache* _yulFunctionCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
@@ -61,13 +62,16 @@ public:
 			std::move(_optimiserSettings),
 			std::move(_sourceIndices),
 			_debugInfoSelection,
-			_soliditySourceProvider
+			_soliditySourceProvider,
+			_yulFunctionCache
 		),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
 	/// Generates and returns the IR code, in unoptimized and optimized form
 	/// (or just pretty-printed, depending on the optimizer settings).
+	/// The unoptimized code is returned as generated, i.e. without consistent indentation,
+	/// because it is only parsed; use yul::reindent to format it for output.
 	std::pair<std::string, std::string> run(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
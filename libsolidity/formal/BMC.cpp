@@ -44,7 +44,14 @@ BMC::BMC(
 	CharStreamProvider const& _charStreamProvider
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout))
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_settings.solvers,
+		_settings.timeout,
+		_settings.threads,
+		_settings.cacheDirectory ? make_shared<smtutil::QueryResultStore>(*_settings.cacheDirectory) : nullptr
+	))
 {
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
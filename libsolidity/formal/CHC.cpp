@@ -33,6 +33,7 @@
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -69,6 +70,8 @@ CHC::CHC(
 	m_smtlib2Responses(_smtlib2Responses),
 	m_smtCallback(_smtCallback)
 {
+	if (m_settings.cacheDirectory)
+		m_resultStore = make_unique<QueryResultStore>(*m_settings.cacheDirectory);
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -607,7 +610,7 @@ void CHC::endVisit(IndexRangeAccess const& _range)
 	if (!sliceData.first)
 	{
 		for (auto pred: sliceData.second.predicates)
-			m_interface->registerRelation(pred->functor());
+			registerRelation(pred->functor());
 		for (auto const& rule: sliceData.second.rules)
 			addRule(rule, "");
 	}
@@ -1022,6 +1025,12 @@ void CHC::resetSourceAnalysis()
 	m_context.reset();
 	m_context.resetUniqueId();
 	m_context.setAssertionAccumulation(false);
+
+	// Only the directly linked z3 can be used from several threads,
+	// each solver instance having its own context.
+	m_solveConcurrently = usesZ3 && m_settings.threads > 1;
+	m_solverCommands.clear();
+	m_context.setDeclarationRecording(m_solveConcurrently);
 }
 
 void CHC::resetContractAnalysis()
@@ -1132,7 +1141,7 @@ SortPointer CHC::sort(ASTNode const* _node)
 Predicate const* CHC::createSymbolicBlock(SortPointer _sort, string const& _name, PredicateType _predType, ASTNode const* _node, ContractDefinition const* _contractContext)
 {
 	auto const* block = Predicate::create(_sort, _name, _predType, m_context, _node, _contractContext, m_scopes);
-	m_interface->registerRelation(block->functor());
+	registerRelation(block->functor());
 	return block;
 }
 
@@ -1364,7 +1373,7 @@ void CHC::createErrorBlock()
 		"error_target_" + to_string(m_context.newUniqueId()),
 		PredicateType::Error
 	);
-	m_interface->registerRelation(m_errorPredicate->functor());
+	registerRelation(m_errorPredicate->functor());
 }
 
 void CHC::connectBlocks(smtutil::Expression const& _from, smtutil::Expression const& _to, smtutil::Expression const& _constraints)
@@ -1539,42 +1548,80 @@ smtutil::Expression CHC::predicate(FunctionCall const& _funCall)
 void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 {
 	m_interface->addRule(_rule, _ruleName);
+	if (m_solveConcurrently)
+		m_solverCommands.push_back({m_context.declarations().size(), _rule, _ruleName});
+}
+
+void CHC::registerRelation(smtutil::Expression const& _relation)
+{
+	m_interface->registerRelation(_relation);
+	if (m_solveConcurrently)
+		m_solverCommands.push_back({m_context.declarations().size(), _relation, nullopt});
 }
 
 tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
 {
+	auto queryResult = querySolver(*m_interface, _query);
+	reportQueryResult(get<0>(queryResult), _location);
+	return queryResult;
+}
+
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::querySolver(
+	CHCSolverInterface& _solver,
+	smtutil::Expression const& _query
+)
+{
+	// Neither invariants nor counterexamples are stored, so stored results can
+	// only be used for safe targets, and only if no invariants are requested.
+	optional<h256> resultKey;
+	if (m_resultStore && m_settings.invariants.invariants.empty())
+	{
+		string solverName = "smtlib2";
+#ifdef HAVE_Z3
+		if (dynamic_cast<Z3CHCInterface*>(&_solver))
+			solverName = "z3 " + Z3Interface::version();
+#endif
+		resultKey = QueryResultStore::key(_solver.dumpQuery(_query), solverName, m_settings.timeout);
+		auto storedResult = m_resultStore->load(*resultKey);
+		if (storedResult && storedResult->first == CheckResult::UNSATISFIABLE)
+			return {CheckResult::UNSATISFIABLE, smtutil::Expression(true), {}};
+	}
+
 	CheckResult result;
 	smtutil::Expression invariant(true);
 	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	tie(result, invariant, cex) = _solver.query(_query);
+	if (resultKey && result == CheckResult::UNSATISFIABLE)
+		m_resultStore->store(*resultKey, result, {});
 #ifdef HAVE_Z3
-		if (m_settings.solvers.z3)
-		{
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
+	if (result == CheckResult::SATISFIABLE && m_settings.solvers.z3)
+	{
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_solver);
+		solAssert(spacer, "");
+		spacer->setSpacerOptions(false);
 
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+		CheckResult resultNoOpt;
+		smtutil::Expression invariantNoOpt(true);
+		CHCSolverInterface::CexGraph cexNoOpt;
+		tie(resultNoOpt, invariantNoOpt, cexNoOpt) = _solver.query(_query);
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = move(cexNoOpt);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			cex = move(cexNoOpt);
 
-			spacer->setSpacerOptions(true);
-		}
-#endif
-		break;
+		spacer->setSpacerOptions(true);
 	}
+#endif
+	return {result, invariant, cex};
+}
+
+void CHC::reportQueryResult(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1584,7 +1631,6 @@ tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1642,6 +1688,7 @@ void CHC::checkVerificationTargets()
 	}
 
 	set<unsigned> checkedErrorIds;
+	vector<CHCTargetCheck> targetChecks;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
 		string errorType;
@@ -1696,10 +1743,16 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		targetChecks.push_back({target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here."});
 		checkedErrorIds.insert(target.errorId);
 	}
 
+	if (m_solveConcurrently)
+		checkAndReportTargetsConcurrently(targetChecks);
+	else
+		for (auto const& check: targetChecks)
+			checkAndReportTarget(check.target, check.placeholders, check.errorReporterId, check.satMsg, check.unknownMsg);
+
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
 		for (auto const& [node, targets]: m_unprovedTargets)
@@ -1795,9 +1848,68 @@ void CHC::checkAndReportTarget(
 	string _unknownMsg
 )
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
+	if (isReportedUnsafe(_target))
 		return;
 
+	smtutil::Expression targetQuery = createTargetQuery(_target, _placeholders);
+	auto queryResult = query(targetQuery, _target.errorNode->location());
+	reportTarget(_target, targetQuery, queryResult, _errorReporterId, _satMsg, _unknownMsg);
+}
+
+void CHC::checkAndReportTargetsConcurrently(vector<CHCTargetCheck> const& _checks)
+{
+	solAssert(m_solveConcurrently);
+
+	// Encode all queries first, so that every solver instance receives the same rules.
+	// The rules of the other targets do not influence a query, since each target has its own error block.
+	vector<optional<smtutil::Expression>> targetQueries;
+	for (auto const& check: _checks)
+		if (isReportedUnsafe(check.target))
+			targetQueries.emplace_back();
+		else
+			targetQueries.emplace_back(createTargetQuery(check.target, check.placeholders));
+
+	vector<tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>> queryResults(
+		targetQueries.size(),
+		{CheckResult::UNKNOWN, smtutil::Expression(true), {}}
+	);
+#ifdef HAVE_Z3
+	size_t const solverCount = min<size_t>(m_settings.threads, targetQueries.size());
+	// The solvers are created sequentially, since their constructors set global z3 parameters.
+	vector<unique_ptr<Z3CHCInterface>> solvers;
+	for (size_t i = 0; i < solverCount; ++i)
+		solvers.emplace_back(make_unique<Z3CHCInterface>(m_settings.timeout));
+
+	parallelFor(solverCount, static_cast<unsigned>(solverCount), [&](size_t _solverIndex) {
+		Z3CHCInterface& solver = *solvers.at(_solverIndex);
+		replaySolverCommands(solver);
+		for (size_t i = _solverIndex; i < targetQueries.size(); i += solverCount)
+			if (targetQueries[i])
+				queryResults[i] = querySolver(solver, *targetQueries[i]);
+	});
+#endif
+
+	for (size_t i = 0; i < _checks.size(); ++i)
+	{
+		auto const& check = _checks[i];
+		// Another target for the same node might have been found unsafe in the meantime.
+		if (!targetQueries[i] || isReportedUnsafe(check.target))
+			continue;
+		reportQueryResult(get<0>(queryResults[i]), check.target.errorNode->location());
+		reportTarget(check.target, *targetQueries[i], queryResults[i], check.errorReporterId, check.satMsg, check.unknownMsg);
+	}
+}
+
+bool CHC::isReportedUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
+smtutil::Expression CHC::createTargetQuery(
+	CHCVerificationTarget const& _target,
+	vector<CHCQueryPlaceholder> const& _placeholders
+)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -1805,8 +1917,20 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+	return error();
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	smtutil::Expression const& _query,
+	tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> const& _queryResult,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg
+)
+{
+	auto const& [result, invariant, model] = _queryResult;
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target.type);
@@ -1822,7 +1946,7 @@ void CHC::checkAndReportTarget(
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(model, _query.name);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
@@ -1844,6 +1968,22 @@ void CHC::checkAndReportTarget(
 		};
 }
 
+void CHC::replaySolverCommands(CHCSolverInterface& _solver) const
+{
+	auto const& declarations = m_context.declarations();
+	size_t declared = 0;
+	for (auto const& command: m_solverCommands)
+	{
+		solAssert(command.declarationCount <= declarations.size());
+		for (; declared < command.declarationCount; ++declared)
+			_solver.declareVariable(declarations[declared].first, declarations[declared].second);
+		if (command.ruleName)
+			_solver.addRule(command.expression, *command.ruleName);
+		else
+			_solver.registerRelation(command.expression);
+	}
+}
+
 /**
 The counterexample DAG has the following properties:
 1) The root node represents the reachable error predicate.
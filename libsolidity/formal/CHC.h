@@ -38,6 +38,7 @@
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/QueryResultStore.h>
 
 #include <liblangutil/SourceLocation.h>
 #include <liblangutil/UniqueErrorReporter.h>
@@ -245,9 +246,18 @@ private:
 	//@{
 	/// Adds Horn rule to the solver.
 	void addRule(smtutil::Expression const& _rule, std::string const& _ruleName);
+	/// Registers the functor of a predicate as a relation in the solver.
+	void registerRelation(smtutil::Expression const& _relation);
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Queries @param _solver without reporting anything.
+	/// If the query is satisfiable and z3 is used, it is repeated without
+	/// Spacer's preprocessing in order to obtain a complete counterexample.
+	/// Safe results are looked up in and added to the result store, if there is one.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> querySolver(smtutil::CHCSolverInterface& _solver, smtutil::Expression const& _query);
+	/// Reports conflicting answers and solver errors of a query.
+	void reportQueryResult(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -255,6 +265,7 @@ private:
 	// Forward declarations. Definitions are below.
 	struct CHCVerificationTarget;
 	struct CHCQueryPlaceholder;
+	struct CHCTargetCheck;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
 	void checkAndReportTarget(
 		CHCVerificationTarget const& _target,
@@ -263,6 +274,28 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Same as calling checkAndReportTarget for every element of @param _checks, but solves the
+	/// queries concurrently in independent solver instances. Results are reported in order.
+	void checkAndReportTargetsConcurrently(std::vector<CHCTargetCheck> const& _checks);
+	/// @returns true if @param _target was already found to be unsafe.
+	bool isReportedUnsafe(CHCVerificationTarget const& _target) const;
+	/// Creates a new error block that is reachable if the target is violated
+	/// from one of the @param _placeholders and @returns the query for that block.
+	smtutil::Expression createTargetQuery(
+		CHCVerificationTarget const& _target,
+		std::vector<CHCQueryPlaceholder> const& _placeholders
+	);
+	/// Records the result of the reachability query @param _query for @param _target.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		smtutil::Expression const& _query,
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> const& _queryResult,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg
+	);
+	/// Declares the recorded variables and adds the recorded relations and rules to @param _solver.
+	void replaySolverCommands(smtutil::CHCSolverInterface& _solver) const;
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -353,6 +386,17 @@ private:
 		ASTNode const* const errorNode;
 	};
 
+	/// A verification target together with the query entry points and the messages
+	/// used to report it.
+	struct CHCTargetCheck
+	{
+		CHCVerificationTarget const& target;
+		std::vector<CHCQueryPlaceholder> const& placeholders;
+		langutil::ErrorId errorReporterId;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+
 	/// Query placeholder stores information necessary to create the final query edge in the CHC system.
 	/// It is combined with the unique error id (and error type) to create a complete Verification Target.
 	struct CHCQueryPlaceholder
@@ -422,6 +466,26 @@ private:
 	/// CHC solver.
 	std::unique_ptr<smtutil::CHCSolverInterface> m_interface;
 
+	/// Persistent store of query results, if enabled in the settings.
+	std::unique_ptr<smtutil::QueryResultStore const> m_resultStore;
+
+	/// Whether verification targets are solved concurrently in independent solver instances.
+	bool m_solveConcurrently = false;
+
+	/// A relation registration or rule added to m_interface.
+	struct SolverCommand
+	{
+		/// Number of recorded variable declarations at the time the command was issued.
+		size_t declarationCount;
+		smtutil::Expression expression;
+		/// The name of the rule, or nullopt for relation registrations.
+		std::optional<std::string> ruleName;
+	};
+	/// Relations and rules in the order they were added to m_interface.
+	/// Only recorded if m_solveConcurrently is true, in order to replay them
+	/// in the additional solver instances.
+	std::vector<SolverCommand> m_solverCommands;
+
 	std::map<util::h256, std::string> const& m_smtlib2Responses;
 	ReadCallback::Callback const& m_smtCallback;
 };
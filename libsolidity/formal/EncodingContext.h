@@ -50,12 +50,25 @@ public:
 
 	/// Sets the current solver used by the current engine for
 	/// SMT variable declaration.
+	/// Stops recording declarations, see setDeclarationRecording.
 	void setSolver(smtutil::SolverInterface* _solver)
 	{
 		solAssert(_solver, "");
 		m_solver = _solver;
+		setDeclarationRecording(false);
 	}
 
+	/// Sets whether variable declarations forwarded to the solver are recorded,
+	/// so that they can be replayed in other solver instances.
+	/// Clears the previously recorded declarations.
+	void setDeclarationRecording(bool _record)
+	{
+		m_recordDeclarations = _record;
+		m_declarations.clear();
+	}
+	/// @returns the recorded variable declarations in declaration order.
+	std::vector<std::pair<std::string, smtutil::SortPointer>> const& declarations() const { return m_declarations; }
+
 	/// Sets whether the context should conjoin assertions in the assertion stack.
 	void setAssertionAccumulation(bool _acc) { m_accumulateAssertions = _acc; }
 
@@ -63,6 +76,8 @@ public:
 	smtutil::Expression newVariable(std::string _name, smtutil::SortPointer _sort)
 	{
 		solAssert(m_solver, "");
+		if (m_recordDeclarations)
+			m_declarations.emplace_back(_name, _sort);
 		return m_solver->newVariable(move(_name), move(_sort));
 	}
 
@@ -174,6 +189,11 @@ private:
 	/// Solver can be SMT solver or Horn solver in the future.
 	smtutil::SolverInterface* m_solver = nullptr;
 
+	/// Whether variable declarations are recorded in m_declarations.
+	bool m_recordDeclarations = false;
+	/// Recorded variable declarations, see setDeclarationRecording.
+	std::vector<std::pair<std::string, smtutil::SortPointer>> m_declarations;
+
 	/// Assertion stack.
 	std::vector<smtutil::Expression> m_assertions;
 
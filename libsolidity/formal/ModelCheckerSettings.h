@@ -20,6 +20,8 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <optional>
 #include <set>
 
@@ -142,6 +144,9 @@ struct ModelCheckerTargets
 
 struct ModelCheckerSettings
 {
+	/// Directory in which conclusive query results are stored and looked up,
+	/// so that unchanged queries are not solved again in later runs.
+	std::optional<boost::filesystem::path> cacheDirectory;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
@@ -155,12 +160,17 @@ struct ModelCheckerSettings
 	bool showUnproved = false;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
+	/// Maximum number of threads used to solve independent queries concurrently.
+	/// Only the directly linked Z3 solver is used concurrently, since the
+	/// SMT-LIB2 callback is not required to be thread-safe.
+	unsigned threads = 1;
 	std::optional<unsigned> timeout;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
 	{
 		return
+			cacheDirectory == _other.cacheDirectory &&
 			contracts == _other.contracts &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
@@ -168,6 +178,7 @@ struct ModelCheckerSettings
 			showUnproved == _other.showUnproved &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
+			threads == _other.threads &&
 			timeout == _other.timeout;
 	}
 };
@@ -65,6 +65,8 @@
 #include <libyul/YulStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/Utilities.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -76,6 +78,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
 
 #include <json/json.h>
 
@@ -218,11 +221,63 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setThreads(unsigned _threads)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set the number of threads before parsing.");
+	m_threads = _threads;
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
 		solThrow(CompilerError, "Must set EVM version before parsing.");
 	m_evmVersion = _version;
+	m_targetEVMVersion = _version;
+}
+
+void CompilerStack::setAdditionalEVMVersions(vector<EVMVersion> _versions)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set additional EVM versions before parsing.");
+	m_additionalEVMVersions = move(_versions);
+}
+
+vector<EVMVersion> CompilerStack::evmVersions() const
+{
+	vector<EVMVersion> versions{m_evmVersion};
+	for (EVMVersion version: m_additionalEVMVersions)
+		if (find(versions.begin(), versions.end(), version) == versions.end())
+			versions.push_back(version);
+	return versions;
+}
+
+void CompilerStack::selectEVMVersion(EVMVersion _version)
+{
+	if (m_stackState < CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+	if (_version == m_targetEVMVersion)
+		return;
+
+	auto it = m_unselectedContracts.find(_version);
+	if (it == m_unselectedContracts.end())
+		solThrow(CompilerError, "No code was generated for EVM version " + _version.name() + ".");
+
+	map<string const, Contract> contracts;
+	contracts.swap(it->second);
+	m_unselectedContracts.erase(it);
+	m_unselectedContracts[m_targetEVMVersion].swap(m_contracts);
+	m_contracts.swap(contracts);
+	m_targetEVMVersion = _version;
+}
+
+EVMVersion CompilerStack::analysisEVMVersion() const
+{
+	vector<EVMVersion> versions = evmVersions();
+	EVMVersion oldest = *min_element(versions.begin(), versions.end());
+	if (oldest.supportsReturndata() != max_element(versions.begin(), versions.end())->supportsReturndata())
+		solThrow(CompilerError, "Cannot generate code for EVM versions with and without returndata support at the same time.");
+	return oldest;
 }
 
 void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
@@ -301,7 +356,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_threads = 1;
 		m_evmVersion = langutil::EVMVersion();
+		m_additionalEVMVersions.clear();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
 		m_generateEwasm = false;
@@ -314,6 +371,14 @@ void CompilerStack::reset(bool _keepSettings)
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_unselectedContracts.clear();
+	m_targetEVMVersion = m_evmVersion;
+	m_yulFunctionCache.clear();
+	for (size_t kind = 0; kind < artifactKindCount; ++kind)
+	{
+		m_artifactCacheHits[kind] = 0;
+		m_artifactCacheMisses[kind] = 0;
+	}
 	m_errorReporter.clear();
 	TypeProvider::reset();
 }
@@ -338,44 +403,20 @@ bool CompilerStack::parse()
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
-
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	if (m_threads > 1)
+		parseConcurrently(sourcesToParse);
+	else
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
-		if (!source.ast)
-			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		Parser parser{m_errorReporter, analysisEVMVersion(), m_parserErrorRecovery};
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-
-			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
-			{
-				solAssert(!import->path().empty(), "Import path cannot be empty.");
-
-				// The current value of `path` is the absolute path as seen from this source file.
-				// We first have to apply remappings before we can store the actual absolute path
-				// as seen globally.
-				import->annotation().absolutePath = applyRemapping(util::absolutePath(
-					import->path(),
-					path
-				), path);
-			}
-
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
-				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
-					sourcesToParse.push_back(newPath);
-				}
+			string const path = sourcesToParse[i];
+			m_sources[path].ast = parser.parse(*m_sources[path].charStream);
+			processParsedSource(path, sourcesToParse);
 		}
 	}
 
@@ -391,12 +432,104 @@ bool CompilerStack::parse()
 	return !m_hasError;
 }
 
-void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
+void CompilerStack::parseConcurrently(vector<string>& io_sourcesToParse)
+{
+	/// Parser and error reporter for a single source. Each source gets its own
+	/// instances so that sources can be parsed independently of each other.
+	struct SourceParser
+	{
+		SourceParser(EVMVersion _evmVersion, bool _errorRecovery, CharStream& _charStream):
+			parser(errorReporter, _evmVersion, _errorRecovery),
+			charStream(_charStream)
+		{
+			parser.enableNodeTracking();
+		}
+
+		ErrorList errors;
+		ErrorReporter errorReporter{errors};
+		Parser parser;
+		CharStream& charStream;
+		ASTPointer<SourceUnit> ast;
+	};
+
+	// The dialect for inline assembly is created lazily on first use, which is not thread-safe.
+	yul::EVMDialect::strictAssemblyForEVM(analysisEVMVersion());
+
+	int64_t nodeIDOffset = 0;
+	size_t waveStart = 0;
+	while (waveStart < io_sourcesToParse.size())
+	{
+		size_t const waveEnd = io_sourcesToParse.size();
+		vector<unique_ptr<SourceParser>> wave;
+		for (size_t i = waveStart; i < waveEnd; ++i)
+			wave.emplace_back(make_unique<SourceParser>(
+				analysisEVMVersion(),
+				m_parserErrorRecovery,
+				*m_sources.at(io_sourcesToParse[i]).charStream
+			));
+
+		util::parallelFor(wave.size(), m_threads, [&](size_t _index) {
+			wave[_index]->ast = wave[_index]->parser.parse(wave[_index]->charStream);
+		});
+
+		// Reading imports is done here because the read callback is not required to be thread-safe.
+		// Note that the limit on the number of reported errors applies to each source separately.
+		for (size_t i = waveStart; i < waveEnd; ++i)
+		{
+			SourceParser& sourceParser = *wave[i - waveStart];
+			m_errorReporter.append(sourceParser.errors);
+			int64_t const nodeIDCount = sourceParser.parser.nodeIDCount();
+			sourceParser.parser.shiftNodeIDs(nodeIDOffset);
+			nodeIDOffset += nodeIDCount;
+
+			string const path = io_sourcesToParse[i];
+			m_sources[path].ast = move(sourceParser.ast);
+			processParsedSource(path, io_sourcesToParse);
+		}
+		waveStart = waveEnd;
+	}
+}
+
+void CompilerStack::processParsedSource(string const& _path, vector<string>& io_sourcesToParse)
+{
+	Source& source = m_sources[_path];
+	if (!source.ast)
+	{
+		solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
+		return;
+	}
+
+	source.ast->annotation().path = _path;
+
+	for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+	{
+		solAssert(!import->path().empty(), "Import path cannot be empty.");
+
+		// The current value of `path` is the absolute path as seen from this source file.
+		// We first have to apply remappings before we can store the actual absolute path
+		// as seen globally.
+		import->annotation().absolutePath = applyRemapping(util::absolutePath(
+			import->path(),
+			_path
+		), _path);
+	}
+
+	if (m_stopAfter >= ParsedAndImported)
+		for (auto const& newSource: loadMissingSources(*source.ast))
+		{
+			string const& newPath = newSource.first;
+			string const& newContents = newSource.second;
+			m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
+			io_sourcesToParse.push_back(newPath);
+		}
+}
+
+void CompilerStack::importASTs(map<string, Json::Value> _sources)
 {
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
-	m_sourceJsons = _sources;
-	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(m_sourceJsons);
+	m_sourceJsons = std::move(_sources);
+	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(analysisEVMVersion()).jsonToSourceUnit(m_sourceJsons);
 	for (auto& src: reconstructedSources)
 	{
 		string const& path = src.first;
@@ -428,14 +561,17 @@ bool CompilerStack::analyze()
 
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		if (!runPerSource([&](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return SyntaxChecker(_errorReporter, m_optimiserSettings.runYulOptimiser).checkSyntax(_sourceUnit);
+		}))
+			noErrors = false;
+		// The syntax checker fails if there are any errors, including those reported by the parser.
+		if (Error::containsErrors(m_errorReporter.errors()))
+			noErrors = false;
 
 		m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
-		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
+		NameAndTypeResolver resolver(*m_globalContext, analysisEVMVersion(), m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !resolver.registerDeclarations(*source->ast))
 				return false;
@@ -449,22 +585,23 @@ bool CompilerStack::analyze()
 
 		resolver.warnHomonymDeclarations();
 
-		DocStringTagParser docStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
-				noErrors = false;
+		if (!runPerSource([](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return DocStringTagParser(_errorReporter).parseDocStrings(_sourceUnit);
+		}))
+			noErrors = false;
 
 		// Requires DocStringTagParser
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
-		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, analysisEVMVersion());
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
 		// Requires DeclarationTypeChecker to have run
+		DocStringTagParser docStringTagParser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
 				noErrors = false;
@@ -492,7 +629,7 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+		TypeChecker typeChecker(analysisEVMVersion(), m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 				noErrors = false;
@@ -596,6 +733,47 @@ bool CompilerStack::analyze()
 	return !m_hasError;
 }
 
+bool CompilerStack::runPerSource(function<bool(SourceUnit const&, ErrorReporter&)> const& _check)
+{
+	bool success = true;
+	if (m_threads <= 1)
+	{
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !_check(*source->ast, m_errorReporter))
+				success = false;
+		return success;
+	}
+
+	vector<ErrorList> errors(m_sourceOrder.size());
+	vector<exception_ptr> exceptions(m_sourceOrder.size());
+	vector<char> results(m_sourceOrder.size(), true);
+	util::parallelFor(m_sourceOrder.size(), m_threads, [&](size_t _index) {
+		if (!m_sourceOrder[_index]->ast)
+			return;
+		ErrorReporter errorReporter(errors[_index]);
+		try
+		{
+			results[_index] = _check(*m_sourceOrder[_index]->ast, errorReporter);
+		}
+		catch (...)
+		{
+			exceptions[_index] = current_exception();
+		}
+	});
+
+	// Merge in source order and stop at the first exception, as if the sources had been checked one by one.
+	// Note that the limit on the number of reported errors applies to each source separately.
+	for (size_t index = 0; index < m_sourceOrder.size(); ++index)
+	{
+		m_errorReporter.append(errors[index]);
+		if (exceptions[index])
+			rethrow_exception(exceptions[index]);
+		if (!results[index])
+			success = false;
+	}
+	return success;
+}
+
 bool CompilerStack::parseAndAnalyze(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -646,6 +824,41 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		solThrow(CompilerError, "Called compile with errors.");
 
+	// Everything up to here is shared by all EVM versions, code is generated for each of them.
+	// This is not done concurrently, because code generation creates types and Yul strings
+	// in global, unsynchronized repositories.
+	for (EVMVersion version: evmVersions())
+	{
+		if (version != m_targetEVMVersion)
+		{
+			m_unselectedContracts[m_targetEVMVersion].swap(m_contracts);
+			m_targetEVMVersion = version;
+			storeContractDefinitions();
+		}
+		size_t previousErrorCount = m_errorList.size();
+		if (!compileContracts())
+			return false;
+		// Code generation reports its warnings (e.g. about the code size) for every version,
+		// but they are only relevant once. Keep those of the primary version.
+		if (version != m_evmVersion)
+			m_errorList.erase(
+				remove_if(
+					m_errorList.begin() + static_cast<ptrdiff_t>(previousErrorCount),
+					m_errorList.end(),
+					[](shared_ptr<Error const> const& _error) { return !Error::isError(_error->type()); }
+				),
+				m_errorList.end()
+			);
+	}
+
+	m_stackState = CompilationSuccessful;
+	selectEVMVersion(m_evmVersion);
+	this->link();
+	return true;
+}
+
+bool CompilerStack::compileContracts()
+{
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 
@@ -698,19 +911,22 @@ bool CompilerStack::compile(State _stopAfter)
 							throw;
 					}
 				}
-	m_stackState = CompilationSuccessful;
-	this->link();
 	return true;
 }
 
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
-	for (auto& contract: m_contracts)
-	{
-		contract.second.object.link(m_libraries);
-		contract.second.runtimeObject.link(m_libraries);
-	}
+	auto linkContracts = [&](map<string const, Contract>& _contracts) {
+		for (auto& contract: _contracts)
+		{
+			contract.second.object.link(m_libraries);
+			contract.second.runtimeObject.link(m_libraries);
+		}
+	};
+	linkContracts(m_contracts);
+	for (auto& [evmVersion, contracts]: m_unselectedContracts)
+		linkContracts(contracts);
 }
 
 vector<string> CompilerStack::contractNames() const
@@ -754,47 +970,96 @@ evmasm::AssemblyItems const* CompilerStack::runtimeAssemblyItems(string const& _
 	return currentContract.evmRuntimeAssembly ? &currentContract.evmRuntimeAssembly->items() : nullptr;
 }
 
-Json::Value CompilerStack::generatedSources(string const& _contractName, bool _runtime) const
+template<typename T, typename F>
+T const& CompilerStack::cachedArtifact(CachedArtifact<T> const& _artifact, Artifact _kind, F&& _generator) const
+{
+	size_t const kind = static_cast<size_t>(_kind);
+	if (T const* value = _artifact.get())
+	{
+		++m_artifactCacheHits[kind];
+		return *value;
+	}
+
+	lock_guard<recursive_mutex> lock(m_artifactMutex);
+	if (T const* value = _artifact.get())
+	{
+		++m_artifactCacheHits[kind];
+		return *value;
+	}
+	++m_artifactCacheMisses[kind];
+	return _artifact.publish(_generator());
+}
+
+map<string, CompilerStack::ArtifactCacheStatistics> CompilerStack::artifactCacheStatistics() const
+{
+	static map<Artifact, string> const outputNames{
+		{Artifact::Metadata, "metadata"},
+		{Artifact::ABI, "abi"},
+		{Artifact::StorageLayout, "storageLayout"},
+		{Artifact::UserDocumentation, "userdoc"},
+		{Artifact::DevDocumentation, "devdoc"},
+		{Artifact::InterfaceSymbols, "evm.methodIdentifiers"},
+		{Artifact::GeneratedSources, "evm.bytecode.generatedSources"},
+		{Artifact::RuntimeGeneratedSources, "evm.deployedBytecode.generatedSources"},
+		{Artifact::SourceMapping, "evm.bytecode.sourceMap"},
+		{Artifact::RuntimeSourceMapping, "evm.deployedBytecode.sourceMap"},
+		{Artifact::AssemblyString, "evm.assembly"},
+		{Artifact::AssemblyJSON, "evm.legacyAssembly"},
+		{Artifact::YulIR, "ir"},
+		{Artifact::GasEstimates, "evm.gasEstimates"}
+	};
+	solAssert(outputNames.size() == artifactKindCount, "");
+
+	map<string, ArtifactCacheStatistics> statistics;
+	for (auto const& [artifact, outputName]: outputNames)
+	{
+		size_t const kind = static_cast<size_t>(artifact);
+		statistics[outputName] = {m_artifactCacheHits[kind], m_artifactCacheMisses[kind]};
+	}
+	return statistics;
+}
+
+Json::Value const& CompilerStack::generatedSources(string const& _contractName, bool _runtime) const
 {
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	Contract const& c = contract(_contractName);
-	util::LazyInit<Json::Value const> const& sources =
-		_runtime ?
-		c.runtimeGeneratedSources :
-		c.generatedSources;
-	return sources.init([&]{
-		Json::Value sources{Json::arrayValue};
-		// If there is no compiler, then no bytecode was generated and thus no
-		// sources were generated (or we compiled "via IR").
-		if (c.compiler)
-		{
-			solAssert(!m_viaIR, "");
-			string source =
-				_runtime ?
-				c.compiler->runtimeGeneratedYulUtilityCode() :
-				c.compiler->generatedYulUtilityCode();
-			if (!source.empty())
+	return cachedArtifact(
+		_runtime ? c.runtimeGeneratedSources : c.generatedSources,
+		_runtime ? Artifact::RuntimeGeneratedSources : Artifact::GeneratedSources,
+		[&]{
+			Json::Value sources{Json::arrayValue};
+			// If there is no compiler, then no bytecode was generated and thus no
+			// sources were generated (or we compiled "via IR").
+			if (c.compiler)
 			{
-				string sourceName = CompilerContext::yulUtilityFileName();
-				unsigned sourceIndex = sourceIndices()[sourceName];
-				ErrorList errors;
-				ErrorReporter errorReporter(errors);
-				CharStream charStream(source, sourceName);
-				yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-				shared_ptr<yul::Block> parserResult = yul::Parser{errorReporter, dialect}.parse(charStream);
-				solAssert(parserResult, "");
-				sources[0]["ast"] = yul::AsmJsonConverter{sourceIndex}(*parserResult);
-				sources[0]["name"] = sourceName;
-				sources[0]["id"] = sourceIndex;
-				sources[0]["language"] = "Yul";
-				sources[0]["contents"] = move(source);
+				solAssert(!m_viaIR, "");
+				string source =
+					_runtime ?
+					c.compiler->runtimeGeneratedYulUtilityCode() :
+					c.compiler->generatedYulUtilityCode();
+				if (!source.empty())
+				{
+					string sourceName = CompilerContext::yulUtilityFileName();
+					unsigned sourceIndex = sourceIndices()[sourceName];
+					ErrorList errors;
+					ErrorReporter errorReporter(errors);
+					CharStream charStream(source, sourceName);
+					yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_targetEVMVersion);
+					shared_ptr<yul::Block> parserResult = yul::Parser{errorReporter, dialect}.parse(charStream);
+					solAssert(parserResult, "");
+					sources[0]["ast"] = yul::AsmJsonConverter{sourceIndex}(*parserResult);
+					sources[0]["name"] = sourceName;
+					sources[0]["id"] = sourceIndex;
+					sources[0]["language"] = "Yul";
+					sources[0]["contents"] = move(source);
 
+				}
 			}
+			return sources;
 		}
-		return sources;
-	});
+	);
 }
 
 string const* CompilerStack::sourceMapping(string const& _contractName) const
@@ -802,13 +1067,12 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& c = contract(_contractName);
-	if (!c.sourceMapping)
-	{
-		if (auto items = assemblyItems(_contractName))
-			c.sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices()));
-	}
-	return c.sourceMapping ? &*c.sourceMapping : nullptr;
+	evmasm::AssemblyItems const* items = assemblyItems(_contractName);
+	if (!items)
+		return nullptr;
+	return &cachedArtifact(contract(_contractName).sourceMapping, Artifact::SourceMapping, [&]{
+		return evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices());
+	});
 }
 
 string const* CompilerStack::runtimeSourceMapping(string const& _contractName) const
@@ -816,15 +1080,12 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& c = contract(_contractName);
-	if (!c.runtimeSourceMapping)
-	{
-		if (auto items = runtimeAssemblyItems(_contractName))
-			c.runtimeSourceMapping.emplace(
-				evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices())
-			);
-	}
-	return c.runtimeSourceMapping ? &*c.runtimeSourceMapping : nullptr;
+	evmasm::AssemblyItems const* items = runtimeAssemblyItems(_contractName);
+	if (!items)
+		return nullptr;
+	return &cachedArtifact(contract(_contractName).runtimeSourceMapping, Artifact::RuntimeSourceMapping, [&]{
+		return evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices());
+	});
 }
 
 std::string const CompilerStack::filesystemFriendlyName(string const& _contractName) const
@@ -856,7 +1117,10 @@ string const& CompilerStack::yulIR(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIR;
+	Contract const& currentContract = contract(_contractName);
+	return cachedArtifact(currentContract.formattedYulIR, Artifact::YulIR, [&]{
+		return currentContract.yulIR.empty() ? string() : yul::reindent(currentContract.yulIR);
+	});
 }
 
 string const& CompilerStack::yulIROptimized(string const& _contractName) const
@@ -899,30 +1163,55 @@ evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contract
 	return contract(_contractName).runtimeObject;
 }
 
-/// TODO: cache this string
 string CompilerStack::assemblyString(string const& _contractName, StringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	Contract const& currentContract = contract(_contractName);
-	if (currentContract.evmAssembly)
-		return currentContract.evmAssembly->assemblyString(m_debugInfoSelection, _sourceCodes);
-	else
+	if (!currentContract.evmAssembly)
 		return string();
+
+	// The source codes are quoted in the output, so only the assembly for the source codes
+	// of the first request is cached. Tools keep requesting it with the same ones.
+	auto cached = [&]() -> string const* {
+		auto const* sourcesAndAssembly = currentContract.assemblyString.get();
+		if (sourcesAndAssembly && sourcesAndAssembly->first == _sourceCodes)
+			return &sourcesAndAssembly->second;
+		return nullptr;
+	};
+	size_t const kind = static_cast<size_t>(Artifact::AssemblyString);
+	if (string const* assembly = cached())
+	{
+		++m_artifactCacheHits[kind];
+		return *assembly;
+	}
+
+	lock_guard<recursive_mutex> lock(m_artifactMutex);
+	if (string const* assembly = cached())
+	{
+		++m_artifactCacheHits[kind];
+		return *assembly;
+	}
+	++m_artifactCacheMisses[kind];
+	string assembly = currentContract.evmAssembly->assemblyString(m_debugInfoSelection, _sourceCodes);
+	if (!currentContract.assemblyString.get())
+		currentContract.assemblyString.publish({_sourceCodes, assembly});
+	return assembly;
 }
 
-/// TODO: cache the JSON
-Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
+Json::Value const& CompilerStack::assemblyJSON(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	Contract const& currentContract = contract(_contractName);
-	if (currentContract.evmAssembly)
-		return currentContract.evmAssembly->assemblyJSON(sourceIndices());
-	else
-		return Json::Value();
+	return cachedArtifact(currentContract.assemblyJSON, Artifact::AssemblyJSON, [&]{
+		if (currentContract.evmAssembly)
+			return currentContract.evmAssembly->assemblyJSON(sourceIndices());
+		else
+			return Json::Value();
+	});
 }
 
 vector<string> CompilerStack::sourceNames() const
@@ -959,7 +1248,7 @@ Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.abi.init([&]{ return ABI::generate(*_contract.contract); });
+	return cachedArtifact(_contract.abi, Artifact::ABI, [&]{ return ABI::generate(*_contract.contract); });
 }
 
 Json::Value const& CompilerStack::storageLayout(string const& _contractName) const
@@ -977,7 +1266,7 @@ Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.storageLayout.init([&]{ return StorageLayout().generate(*_contract.contract); });
+	return cachedArtifact(_contract.storageLayout, Artifact::StorageLayout, [&]{ return StorageLayout().generate(*_contract.contract); });
 }
 
 Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
@@ -995,7 +1284,7 @@ Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.userDocumentation.init([&]{ return Natspec::userDocumentation(*_contract.contract); });
+	return cachedArtifact(_contract.userDocumentation, Artifact::UserDocumentation, [&]{ return Natspec::userDocumentation(*_contract.contract); });
 }
 
 Json::Value const& CompilerStack::natspecDev(string const& _contractName) const
@@ -1013,37 +1302,39 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.devDocumentation.init([&]{ return Natspec::devDocumentation(*_contract.contract); });
+	return cachedArtifact(_contract.devDocumentation, Artifact::DevDocumentation, [&]{ return Natspec::devDocumentation(*_contract.contract); });
 }
 
-Json::Value CompilerStack::interfaceSymbols(string const& _contractName) const
+Json::Value const& CompilerStack::interfaceSymbols(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
-	Json::Value interfaceSymbols(Json::objectValue);
-	// Always have a methods object
-	interfaceSymbols["methods"] = Json::objectValue;
-
-	for (auto const& it: contractDefinition(_contractName).interfaceFunctions())
-		interfaceSymbols["methods"][it.second->externalSignature()] = it.first.hex();
-	for (ErrorDefinition const* error: contractDefinition(_contractName).interfaceErrors())
-	{
-		string signature = error->functionType(true)->externalSignature();
-		interfaceSymbols["errors"][signature] = util::toHex(toCompactBigEndian(util::selectorFromSignature32(signature), 4));
-	}
+	return cachedArtifact(contract(_contractName).interfaceSymbols, Artifact::InterfaceSymbols, [&]{
+		Json::Value interfaceSymbols(Json::objectValue);
+		// Always have a methods object
+		interfaceSymbols["methods"] = Json::objectValue;
 
-	for (EventDefinition const* event: ranges::concat_view(
-		contractDefinition(_contractName).definedInterfaceEvents(),
-		contractDefinition(_contractName).usedInterfaceEvents()
-	))
-		if (!event->isAnonymous())
+		for (auto const& it: contractDefinition(_contractName).interfaceFunctions())
+			interfaceSymbols["methods"][it.second->externalSignature()] = it.first.hex();
+		for (ErrorDefinition const* error: contractDefinition(_contractName).interfaceErrors())
 		{
-			string signature = event->functionType(true)->externalSignature();
-			interfaceSymbols["events"][signature] = toHex(u256(h256::Arith(util::keccak256(signature))));
+			string signature = error->functionType(true)->externalSignature();
+			interfaceSymbols["errors"][signature] = util::toHex(toCompactBigEndian(util::selectorFromSignature32(signature), 4));
 		}
 
-	return interfaceSymbols;
+		for (EventDefinition const* event: ranges::concat_view(
+			contractDefinition(_contractName).definedInterfaceEvents(),
+			contractDefinition(_contractName).usedInterfaceEvents()
+		))
+			if (!event->isAnonymous())
+			{
+				string signature = event->functionType(true)->externalSignature();
+				interfaceSymbols["events"][signature] = toHex(u256(h256::Arith(util::keccak256(signature))));
+			}
+
+		return interfaceSymbols;
+	});
 }
 
 bytes CompilerStack::cborMetadata(string const& _contractName, bool _forIR) const
@@ -1061,7 +1352,7 @@ string const& CompilerStack::metadata(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	return _contract.metadata.init([&]{ return createMetadata(_contract, m_viaIR); });
+	return cachedArtifact(_contract.metadata, Artifact::Metadata, [&]{ return createMetadata(_contract, m_viaIR); });
 }
 
 CharStream const& CompilerStack::charStream(string const& _sourceName) const
@@ -1084,6 +1375,27 @@ SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 	return *source(_sourceName).ast;
 }
 
+shared_ptr<SourceUnit const> CompilerStack::sharedAST(string const& _sourceName) const
+{
+	// Performs the same checks as ast().
+	ast(_sourceName);
+	return source(_sourceName).ast;
+}
+
+shared_ptr<CharStream const> CompilerStack::sharedCharStream(string const& _sourceName) const
+{
+	charStream(_sourceName);
+	return source(_sourceName).charStream;
+}
+
+shared_ptr<GlobalContext const> CompilerStack::globalContext() const
+{
+	if (m_stackState < AnalysisPerformed)
+		solThrow(CompilerError, "Analysis was not successful.");
+
+	return m_globalContext;
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1273,7 +1585,7 @@ void CompilerStack::assemble(
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
 	//   contract creation fails with an out of gas error.
 	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
+		m_targetEVMVersion >= langutil::EVMVersion::spuriousDragon() &&
 		compiledContract.runtimeObject.bytecode.size() > 0x6000
 	)
 		m_errorReporter.warning(
@@ -1309,7 +1621,12 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(
+		m_targetEVMVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		&m_yulFunctionCache
+	);
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
@@ -1359,7 +1676,15 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, sourceIndices(), m_debugInfoSelection, this);
+	IRGenerator generator(
+		m_targetEVMVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		sourceIndices(),
+		m_debugInfoSelection,
+		this,
+		&m_yulFunctionCache
+	);
 	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
 		_contract,
 		createCBORMetadata(compiledContract, /* _forIR */ true),
@@ -1383,7 +1708,7 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 
 	// Re-parse the Yul IR in EVM dialect
 	yul::YulStack stack(
-		m_evmVersion,
+		m_targetEVMVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_debugInfoSelection
@@ -1415,7 +1740,7 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 
 	// Re-parse the Yul IR in EVM dialect
 	yul::YulStack stack(
-		m_evmVersion,
+		m_targetEVMVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_debugInfoSelection
@@ -1552,7 +1877,7 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 
 	if (_forIR)
 		meta["settings"]["viaIR"] = _forIR;
-	meta["settings"]["evmVersion"] = m_evmVersion.name();
+	meta["settings"]["evmVersion"] = m_targetEVMVersion.name();
 	meta["settings"]["compilationTarget"][_contract.contract->sourceUnitName()] =
 		*_contract.contract->annotation().canonicalName;
 
@@ -1705,22 +2030,29 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
-Json::Value CompilerStack::gasEstimates(string const& _contractName) const
+Json::Value const& CompilerStack::gasEstimates(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
+	return cachedArtifact(contract(_contractName).gasEstimates, Artifact::GasEstimates, [&]{
+		return computeGasEstimates(_contractName);
+	});
+}
+
+Json::Value CompilerStack::computeGasEstimates(string const& _contractName) const
+{
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
 		return Json::Value();
 
 	using Gas = GasEstimator::GasConsumption;
-	GasEstimator gasEstimator(m_evmVersion);
+	GasEstimator gasEstimator(m_targetEVMVersion);
 	Json::Value output(Json::objectValue);
 
 	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
 	{
 		Gas executionGas = gasEstimator.functionalEstimation(*items);
-		Gas codeDepositGas{evmasm::GasMeter::dataGas(runtimeObject(_contractName).bytecode, false, m_evmVersion)};
+		Gas codeDepositGas{evmasm::GasMeter::dataGas(runtimeObject(_contractName).bytecode, false, m_targetEVMVersion)};
 
 		Json::Value creation(Json::objectValue);
 		creation["codeDepositCost"] = gasToJson(codeDepositGas);
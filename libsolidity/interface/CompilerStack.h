@@ -25,6 +25,7 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -45,12 +46,15 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
-#include <libsolutil/LazyInit.h>
 
 #include <json/json.h>
 
+#include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -169,11 +173,40 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to parse and analyze sources concurrently.
+	/// Only parsing and the analysis steps that are local to a single source are parallelized.
+	/// When called without an argument it will revert to running everything on the calling thread.
+	/// Must be set before parsing.
+	void setThreads(unsigned _threads = 1);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
 	void setEVMVersion(langutil::EVMVersion _version = langutil::EVMVersion{});
 
+	/// Sets EVM versions to generate code for in addition to the one set by setEVMVersion.
+	/// The sources are parsed and analyzed only once, for the oldest of all versions, so that only
+	/// features available on every target are accepted. Code generation and optimisation are run
+	/// for every version. Either all or none of the versions have to support returndata, because
+	/// the types of some expressions depend on it.
+	/// When called without an argument it will revert to generating code for a single version.
+	/// Must be set before parsing.
+	void setAdditionalEVMVersions(std::vector<langutil::EVMVersion> _versions = {});
+
+	/// @returns the EVM version set by setEVMVersion followed by the additional EVM versions
+	/// that differ from it, without duplicates.
+	std::vector<langutil::EVMVersion> evmVersions() const;
+
+	/// Selects the EVM version whose results are returned by all functions that provide generated
+	/// code or artifacts depending on it (bytecode, assembly, IR, metadata, gas estimates, ...).
+	/// @a _version has to be one of evmVersions(). Switching is cheap, since the results of
+	/// all versions are kept. After compilation, the version set by setEVMVersion is selected.
+	/// Can only be called after successful compilation and not concurrently with other calls.
+	void selectEVMVersion(langutil::EVMVersion _version);
+
+	/// @returns the EVM version whose results are currently selected.
+	langutil::EVMVersion selectedEVMVersion() const { return m_targetEVMVersion; }
+
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 
@@ -220,7 +253,7 @@ public:
 
 	/// Imports given SourceUnits so they can be analyzed. Leads to the same internal state as parse().
 	/// Will throw errors if the import fails
-	void importASTs(std::map<std::string, Json::Value> const& _sources);
+	void importASTs(std::map<std::string, Json::Value> _sources);
 
 	/// Performs the analysis steps (imports, scopesetting, syntaxCheck, referenceResolving,
 	///  typechecking, staticAnalysis) on previously parsed sources.
@@ -248,6 +281,16 @@ public:
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// @returns the parsed source unit with the supplied name, sharing its ownership so that
+	/// it outlives a reset of the compiler stack.
+	std::shared_ptr<SourceUnit const> sharedAST(std::string const& _sourceName) const;
+
+	/// @returns the character stream of the supplied source, sharing its ownership.
+	std::shared_ptr<langutil::CharStream const> sharedCharStream(std::string const& _sourceName) const;
+
+	/// @returns the context owning the global declarations referenced from the analysed sources.
+	std::shared_ptr<GlobalContext const> globalContext() const;
+
 	/// @returns the parsed contract with the supplied name. Throws an exception if the contract
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
@@ -291,7 +334,7 @@ public:
 
 	/// @returns an array containing all utility sources generated during compilation.
 	/// Format: [ { name: string, id: number, language: "Yul", contents: string }, ... ]
-	Json::Value generatedSources(std::string const& _contractName, bool _runtime = false) const;
+	Json::Value const& generatedSources(std::string const& _contractName, bool _runtime = false) const;
 
 	/// @returns the string that provides a mapping between bytecode and sourcecode or a nullptr
 	/// if the contract does not (yet) have bytecode.
@@ -303,13 +346,13 @@ public:
 
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
+	/// Only the representation for the source codes of the first request is cached.
 	/// Prerequisite: Successful compilation.
 	std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
-	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	Json::Value assemblyJSON(std::string const& _contractName) const;
+	Json::Value const& assemblyJSON(std::string const& _contractName) const;
 
 	/// @returns a JSON representing the contract ABI.
 	/// Prerequisite: Successful call to parse or compile.
@@ -328,7 +371,7 @@ public:
 	Json::Value const& natspecDev(std::string const& _contractName) const;
 
 	/// @returns a JSON object with the three members ``methods``, ``events``, ``errors``. Each is a map, mapping identifiers (hashes) to function names.
-	Json::Value interfaceSymbols(std::string const& _contractName) const;
+	Json::Value const& interfaceSymbols(std::string const& _contractName) const;
 
 	/// @returns the Contract Metadata matching the pipeline selected using the viaIR setting.
 	std::string const& metadata(std::string const& _contractName) const { return metadata(contract(_contractName)); }
@@ -342,7 +385,20 @@ public:
 	bytes cborMetadata(std::string const& _contractName, bool _forIR) const;
 
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
-	Json::Value gasEstimates(std::string const& _contractName) const;
+	Json::Value const& gasEstimates(std::string const& _contractName) const;
+
+	/// Number of requests for a kind of per-contract artifact that were served from the cache
+	/// and that had to compute the artifact.
+	struct ArtifactCacheStatistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+	};
+
+	/// @returns the cache statistics of the per-contract artifacts (ABI, metadata, assembly, gas
+	/// estimates, ...) since the last reset, indexed by the name of the corresponding Standard JSON
+	/// output, e.g. "abi" or "evm.gasEstimates". Meant for profiling tools that request outputs repeatedly.
+	std::map<std::string, ArtifactCacheStatistics> artifactCacheStatistics() const;
 
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	/// This is mostly a workaround to avoid bytecode and gas differences between compiler builds
@@ -364,6 +420,52 @@ private:
 		std::string const& ipfsUrl() const;
 	};
 
+	/// Kinds of artifacts that are computed from a compiled contract on request and cached per contract.
+	enum class Artifact: size_t
+	{
+		Metadata,
+		ABI,
+		StorageLayout,
+		UserDocumentation,
+		DevDocumentation,
+		InterfaceSymbols,
+		GeneratedSources,
+		RuntimeGeneratedSources,
+		SourceMapping,
+		RuntimeSourceMapping,
+		AssemblyString,
+		AssemblyJSON,
+		YulIR,
+		GasEstimates
+	};
+	static size_t constexpr artifactKindCount = static_cast<size_t>(Artifact::GasEstimates) + 1;
+
+	/// An artifact of a contract that is computed on first request and cached afterwards.
+	/// The value is computed and published by cachedArtifact() while holding m_artifactMutex
+	/// and can be read without locking once it is published.
+	template<typename T>
+	class CachedArtifact
+	{
+	public:
+		CachedArtifact() = default;
+		CachedArtifact(CachedArtifact const&) = delete;
+		CachedArtifact& operator=(CachedArtifact const&) = delete;
+
+		/// @returns the cached value or nullptr if it has not been published yet.
+		T const* get() const { return m_published.load(std::memory_order_acquire); }
+		/// Stores @a _value and makes it visible to get(). May only be called once.
+		T const& publish(T _value) const
+		{
+			m_value.emplace(std::move(_value));
+			m_published.store(&*m_value, std::memory_order_release);
+			return *m_value;
+		}
+
+	private:
+		mutable std::optional<T> m_value;
+		mutable std::atomic<T const*> m_published{nullptr};
+	};
+
 	/// The state per contract. Filled gradually during compilation.
 	struct Contract
 	{
@@ -373,19 +475,25 @@ private:
 		std::shared_ptr<evmasm::Assembly> evmRuntimeAssembly;
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
-		std::string yulIR; ///< Yul IR code.
+		std::string yulIR; ///< Yul IR code as generated, without consistent indentation.
 		std::string yulIROptimized; ///< Optimized Yul IR code.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
-		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
-		util::LazyInit<Json::Value const> abi;
-		util::LazyInit<Json::Value const> storageLayout;
-		util::LazyInit<Json::Value const> userDocumentation;
-		util::LazyInit<Json::Value const> devDocumentation;
-		util::LazyInit<Json::Value const> generatedSources;
-		util::LazyInit<Json::Value const> runtimeGeneratedSources;
-		mutable std::optional<std::string const> sourceMapping;
-		mutable std::optional<std::string const> runtimeSourceMapping;
+		CachedArtifact<std::string> metadata; ///< The metadata json that will be hashed into the chain.
+		CachedArtifact<Json::Value> abi;
+		CachedArtifact<Json::Value> storageLayout;
+		CachedArtifact<Json::Value> userDocumentation;
+		CachedArtifact<Json::Value> devDocumentation;
+		CachedArtifact<Json::Value> interfaceSymbols;
+		CachedArtifact<Json::Value> generatedSources;
+		CachedArtifact<Json::Value> runtimeGeneratedSources;
+		CachedArtifact<std::string> sourceMapping;
+		CachedArtifact<std::string> runtimeSourceMapping;
+		/// The assembly text together with the source codes it was created for.
+		CachedArtifact<std::pair<StringMap, std::string>> assemblyString;
+		CachedArtifact<Json::Value> assemblyJSON;
+		CachedArtifact<Json::Value> gasEstimates;
+		CachedArtifact<std::string> formattedYulIR; ///< Reindented Yul IR code for output.
 	};
 
 	void createAndAssignCallGraphs();
@@ -395,6 +503,20 @@ private:
 	/// @a m_readFile
 	/// @returns the newly loaded sources.
 	StringMap loadMissingSources(SourceUnit const& _ast);
+	/// Parses the sources in @a io_sourcesToParse concurrently, in waves: all sources known at the
+	/// start of a wave are parsed in parallel, then their imports are loaded on the calling thread
+	/// and appended to @a io_sourcesToParse for the next wave. Errors and node IDs are merged in
+	/// the order of @a io_sourcesToParse, so the result matches parsing the sources one by one.
+	void parseConcurrently(std::vector<std::string>& io_sourcesToParse);
+	/// Runs @a _check on the AST of every source in m_sourceOrder. If more than one thread is
+	/// requested, the sources are checked concurrently, each reporting to its own error list,
+	/// and the lists are merged in source order afterwards. Only suitable for checks that
+	/// neither read nor modify anything outside of the source they are given.
+	/// @returns false if @a _check returned false for any source.
+	bool runPerSource(std::function<bool(SourceUnit const&, langutil::ErrorReporter&)> const& _check);
+	/// Sets the annotations of the freshly parsed source @a _path and, if requested, loads
+	/// its missing imports and appends them to @a io_sourcesToParse.
+	void processParsedSource(std::string const& _path, std::vector<std::string>& io_sourcesToParse);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
@@ -435,6 +557,13 @@ private:
 	/// Depends on output generated by generateIR.
 	void generateEwasm(ContractDefinition const& _contract);
 
+	/// @returns the oldest of evmVersions(), which is used for parsing and analysis.
+	langutil::EVMVersion analysisEVMVersion() const;
+
+	/// Generates code for all requested contracts for the EVM version m_targetEVMVersion.
+	/// @returns false on error.
+	bool compileContracts();
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -475,6 +604,14 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const& _contract) const;
 
+	/// @returns the artifact @a _artifact of kind @a _kind, which is computed by @a _generator
+	/// if it is not cached yet, and counts the request as a cache hit or miss.
+	template<typename T, typename F>
+	T const& cachedArtifact(CachedArtifact<T> const& _artifact, Artifact _kind, F&& _generator) const;
+
+	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
+	Json::Value computeGasEstimates(std::string const& _contractName) const;
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -488,6 +625,9 @@ private:
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
 	langutil::EVMVersion m_evmVersion;
+	std::vector<langutil::EVMVersion> m_additionalEVMVersions;
+	/// The EVM version code is generated for and whose results are selected.
+	langutil::EVMVersion m_targetEVMVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
@@ -503,6 +643,16 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// The contracts with the results for all EVM versions other than m_targetEVMVersion.
+	std::map<langutil::EVMVersion, std::map<std::string const, Contract>> m_unselectedContracts;
+	/// Helper functions generated by ABIFunctions and YulUtilFunctions for any of the contracts.
+	MultiUseYulFunctionCache m_yulFunctionCache;
+	/// Serializes the computation of cached artifacts. It is shared by all contracts, because the
+	/// generators initialize shared state of the AST and the types lazily, and it is recursive,
+	/// because artifacts are computed from other artifacts (e.g. the metadata contains the ABI).
+	mutable std::recursive_mutex m_artifactMutex;
+	mutable std::array<std::atomic<size_t>, artifactKindCount> m_artifactCacheHits{};
+	mutable std::array<std::atomic<size_t>, artifactKindCount> m_artifactCacheMisses{};
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -510,6 +660,7 @@ private:
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	langutil::DebugInfoSelection m_debugInfoSelection = langutil::DebugInfoSelection::Default();
 	bool m_parserErrorRecovery = false;
+	unsigned m_threads = 1;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
 	/// Whether or not there has been an error during processing.
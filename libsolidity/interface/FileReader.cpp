@@ -37,6 +37,7 @@ using solidity::util::readFileAsString;
 using solidity::util::joinHumanReadable;
 using std::map;
 using std::reference_wrapper;
+using std::size_t;
 using std::string;
 using std::vector;
 
@@ -99,6 +100,12 @@ void FileReader::setSourceUnits(StringMap _sources)
 	m_sourceCodes = std::move(_sources);
 }
 
+void FileReader::setFileCacheLimit(size_t _limit)
+{
+	m_fileCacheLimit = _limit;
+	evictCachedFiles();
+}
+
 ReadCallback::Result FileReader::readFile(string const& _kind, string const& _sourceUnitName)
 {
 	try
@@ -164,7 +171,7 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 			return ReadCallback::Result{false, "Not a valid file."};
 
 		// NOTE: we ignore the FileNotFound exception as we manually check above
-		auto contents = readFileAsString(candidates[0]);
+		auto contents = readFileContents(candidates[0]);
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
 		return ReadCallback::Result{true, contents};
@@ -183,6 +190,56 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 	}
 }
 
+SourceCode FileReader::readFileContents(boost::filesystem::path const& _path)
+{
+	if (m_fileCacheLimit == 0)
+		return readFileAsString(_path);
+
+	uintmax_t size = boost::filesystem::file_size(_path);
+	time_t lastWriteTime = boost::filesystem::last_write_time(_path);
+	if (auto it = m_fileCache.find(_path); it != m_fileCache.end())
+	{
+		CachedFile& cachedFile = it->second;
+		// A file modified within the same second as it was read may have changed without
+		// its size or modification time changing, so such entries are never trusted.
+		if (
+			cachedFile.size == size &&
+			cachedFile.lastWriteTime == lastWriteTime &&
+			cachedFile.lastWriteTime < cachedFile.readTime
+		)
+		{
+			cachedFile.lastUse = ++m_fileCacheUseCounter;
+			return cachedFile.contents;
+		}
+		m_fileCacheSize -= cachedFile.contents.size();
+		m_fileCache.erase(it);
+	}
+
+	time_t readTime = time(nullptr);
+	SourceCode contents = readFileAsString(_path);
+	if (contents.size() <= m_fileCacheLimit)
+	{
+		m_fileCacheSize += contents.size();
+		m_fileCache[_path] = CachedFile{contents, size, lastWriteTime, readTime, ++m_fileCacheUseCounter};
+		evictCachedFiles();
+	}
+	return contents;
+}
+
+void FileReader::evictCachedFiles()
+{
+	while (m_fileCacheSize > m_fileCacheLimit)
+	{
+		auto leastRecentlyUsed = m_fileCache.begin();
+		for (auto it = m_fileCache.begin(); it != m_fileCache.end(); ++it)
+			if (it->second.lastUse < leastRecentlyUsed->second.lastUse)
+				leastRecentlyUsed = it;
+		solAssert(leastRecentlyUsed != m_fileCache.end(), "");
+		m_fileCacheSize -= leastRecentlyUsed->second.contents.size();
+		m_fileCache.erase(leastRecentlyUsed);
+	}
+}
+
 string FileReader::cliPathToSourceUnitName(boost::filesystem::path const& _cliPath) const
 {
 	vector<boost::filesystem::path> prefixes = {m_basePath.empty() ? normalizeCLIPathForVFS(".") : m_basePath};
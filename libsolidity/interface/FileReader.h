@@ -22,6 +22,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <cstdint>
+#include <ctime>
 #include <map>
 #include <set>
 
@@ -73,6 +75,14 @@ public:
 	/// Does not enforce @a allowedDirectories().
 	void addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source);
 
+	/// Keeps the contents of files read from disk in memory, up to @a _limit bytes in total,
+	/// and reuses them as long as the size and modification time of the file do not change.
+	/// Least recently used files are evicted first. A limit of zero disables the cache.
+	/// Only useful in long-running processes that compile the same files repeatedly.
+	void setFileCacheLimit(std::size_t _limit);
+	/// @returns the combined size of all files in the file cache.
+	std::size_t fileCacheSize() const noexcept { return m_fileCacheSize; }
+
 	/// Adds the source code under the source unit name of @a <stdin>.
 	/// Does not enforce @a allowedDirectories().
 	void setStdin(SourceCode _source);
@@ -147,6 +157,20 @@ public:
 	static bool isUNCPath(boost::filesystem::path const& _path);
 
 private:
+	struct CachedFile
+	{
+		SourceCode contents;
+		std::uintmax_t size;
+		std::time_t lastWriteTime;
+		std::time_t readTime;
+		std::uint64_t lastUse;
+	};
+
+	/// @returns the contents of the file at @a _path, from the file cache if possible.
+	SourceCode readFileContents(boost::filesystem::path const& _path);
+	/// Removes least recently used entries from the file cache until it fits the limit.
+	void evictCachedFiles();
+
 	/// If @a _path starts with a number of .. segments, returns a path consisting only of those
 	/// segments (root name is not included). Otherwise returns an empty path. @a _path must be
 	/// absolute (or have slash as root).
@@ -166,6 +190,11 @@ private:
 
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
+
+	std::map<boost::filesystem::path, CachedFile> m_fileCache;
+	std::size_t m_fileCacheLimit = 0;
+	std::size_t m_fileCacheSize = 0;
+	std::uint64_t m_fileCacheUseCounter = 0;
 };
 
 }
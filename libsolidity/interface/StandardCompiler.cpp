@@ -439,13 +439,13 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "additionalEVMVersions", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "threads", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -623,8 +623,174 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 	return { std::move(settings) };
 }
 
+/// Stream buffer that appends everything written to it to a string.
+/// Avoids the copy of the whole output made by std::ostringstream::str().
+class StringAppendBuffer: public std::streambuf
+{
+public:
+	explicit StringAppendBuffer(string& _target): m_target(_target) {}
+
+protected:
+	int_type overflow(int_type _character) override
+	{
+		if (!traits_type::eq_int_type(_character, traits_type::eof()))
+			m_target.push_back(traits_type::to_char_type(_character));
+		return traits_type::not_eof(_character);
+	}
+
+	streamsize xsputn(char const* _data, streamsize _size) override
+	{
+		m_target.append(_data, static_cast<size_t>(_size));
+		return _size;
+	}
+
+private:
+	string& m_target;
+};
+
+}
+
+void StandardCompiler::JsonOutputSink::auxiliaryInputRequested(Json::Value _auxiliaryInput)
+{
+	m_output["auxiliaryInputRequested"] = std::move(_auxiliaryInput);
+}
+
+void StandardCompiler::JsonOutputSink::errors(Json::Value _errors)
+{
+	if (_errors.size() > 0)
+		m_output["errors"] = std::move(_errors);
+}
+
+void StandardCompiler::JsonOutputSink::contract(string const& _file, string const& _name, Json::Value _contractData)
+{
+	m_output["contracts"][_file][_name] = std::move(_contractData);
+}
+
+void StandardCompiler::JsonOutputSink::source(string const& _sourceName, unsigned _id, CompilerStack const& _compilerStack, bool _withAST)
+{
+	Json::Value sourceResult = Json::objectValue;
+	sourceResult["id"] = _id;
+	if (_withAST)
+		sourceResult["ast"] = ASTJsonConverter(_compilerStack.state(), _compilerStack.sourceIndices()).toJson(_compilerStack.ast(_sourceName));
+	m_output["sources"][_sourceName] = std::move(sourceResult);
+}
+
+void StandardCompiler::JsonOutputSink::finish()
+{
+	if (!m_output.isMember("sources"))
+		m_output["sources"] = Json::objectValue;
+}
+
+void StandardCompiler::StreamOutputSink::complete(Json::Value _output)
+{
+	if (!m_started)
+	{
+		m_writer.value(_output);
+		return;
+	}
+
+	// Writing the output already started, so we can only close it and report the errors.
+	for (auto const& error: _output["errors"])
+		m_errors.append(error);
+	end();
+}
+
+void StandardCompiler::StreamOutputSink::auxiliaryInputRequested(Json::Value _auxiliaryInput)
+{
+	start();
+	m_writer.key("auxiliaryInputRequested");
+	m_writer.value(_auxiliaryInput);
+}
+
+void StandardCompiler::StreamOutputSink::errors(Json::Value _errors)
+{
+	m_errors = std::move(_errors);
+}
+
+void StandardCompiler::StreamOutputSink::contract(string const& _file, string const& _name, Json::Value _contractData)
+{
+	start();
+	if (!m_contractsOpen)
+	{
+		m_writer.key("contracts");
+		m_writer.beginObject();
+		m_contractsOpen = true;
+	}
+	if (m_currentFile != _file)
+	{
+		if (m_currentFile)
+			m_writer.endObject();
+		m_writer.key(_file);
+		m_writer.beginObject();
+		m_currentFile = _file;
+	}
+	m_writer.key(_name);
+	m_writer.value(_contractData);
+}
+
+void StandardCompiler::StreamOutputSink::source(string const& _sourceName, unsigned _id, CompilerStack const& _compilerStack, bool _withAST)
+{
+	startSources();
+	m_writer.key(_sourceName);
+	m_writer.beginObject();
+	if (_withAST)
+	{
+		m_writer.key("ast");
+		ASTJsonConverter(_compilerStack.state(), _compilerStack.sourceIndices()).print(m_writer, _compilerStack.ast(_sourceName));
+	}
+	m_writer.key("id");
+	m_writer.value(_id);
+	m_writer.endObject();
 }
 
+void StandardCompiler::StreamOutputSink::finish()
+{
+	startSources();
+	end();
+}
+
+void StandardCompiler::StreamOutputSink::start()
+{
+	if (!m_started)
+		m_writer.beginObject();
+	m_started = true;
+}
+
+void StandardCompiler::StreamOutputSink::startSources()
+{
+	start();
+	if (m_sourcesOpen)
+		return;
+	if (m_contractsOpen)
+	{
+		if (m_currentFile)
+			m_writer.endObject();
+		m_writer.endObject();
+		m_contractsOpen = false;
+	}
+	m_writer.key("sources");
+	m_writer.beginObject();
+	m_sourcesOpen = true;
+}
+
+void StandardCompiler::StreamOutputSink::end()
+{
+	// If writing the errors itself failed, there is nothing left that could be reported.
+	if (m_ended)
+		return;
+	m_ended = true;
+
+	m_writer.endContainers(1);
+	m_contractsOpen = false;
+	m_currentFile.reset();
+	m_sourcesOpen = false;
+	if (m_errors.size() > 0)
+	{
+		m_writer.key("errors");
+		m_writer.value(m_errors);
+	}
+	m_writer.endContainers(0);
+}
 
 std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
 {
@@ -795,6 +961,26 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.evmVersion = *version;
 	}
 
+	if (settings.isMember("additionalEVMVersions"))
+	{
+		if (!settings["additionalEVMVersions"].isArray())
+			return formatFatalError("JSONError", "additionalEVMVersions must be an array of strings.");
+		for (auto const& versionName: settings["additionalEVMVersions"])
+		{
+			if (!versionName.isString())
+				return formatFatalError("JSONError", "additionalEVMVersions must be an array of strings.");
+			std::optional<langutil::EVMVersion> version = langutil::EVMVersion::fromString(versionName.asString());
+			if (!version)
+				return formatFatalError("JSONError", "Invalid EVM version requested.");
+			if (version->supportsReturndata() != ret.evmVersion.supportsReturndata())
+				return formatFatalError(
+					"JSONError",
+					"Additional EVM versions have to be byzantium or newer if and only if evmVersion is."
+				);
+			ret.additionalEVMVersions.push_back(*version);
+		}
+	}
+
 	if (settings.isMember("debug"))
 	{
 		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo"}, "settings.debug"))
@@ -1055,6 +1241,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.targets = targets;
 	}
 
+	if (modelCheckerSettings.isMember("threads"))
+	{
+		if (!modelCheckerSettings["threads"].isUInt() || modelCheckerSettings["threads"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.modelChecker.threads must be a positive integer.");
+		ret.modelCheckerSettings.threads = modelCheckerSettings["threads"].asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("timeout"))
 	{
 		if (!modelCheckerSettings["timeout"].isUInt())
@@ -1065,7 +1258,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, OutputSink& _output)
 {
 	CompilerStack compilerStack(m_readFile);
 
@@ -1075,6 +1268,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+	compilerStack.setAdditionalEVMVersions(_inputsAndSettings.additionalEVMVersions);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
@@ -1233,38 +1427,36 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		((binariesRequested && !compilationSuccess) || !analysisPerformed) &&
 		(errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
 	)
-		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
-
-	Json::Value output = Json::objectValue;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	{
+		_output.complete(formatFatalError("InternalCompilerError", "No error reported, but compilation failed."));
+		return;
+	}
 
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value auxiliaryInput;
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			auxiliaryInput["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_output.auxiliaryInputRequested(std::move(auxiliaryInput));
+	}
 
-	bool const wildcardMatchesExperimental = false;
+	_output.errors(std::move(errors));
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
-		for (string const& sourceName: compilerStack.sourceNames())
-		{
-			Json::Value sourceResult = Json::objectValue;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
+	bool const wildcardMatchesExperimental = false;
 
-	Json::Value contractsOutput = Json::objectValue;
+	// The output is ordered by source and contract name rather than by fully qualified contract name.
+	vector<pair<string, string>> contracts;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		contracts.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	sort(contracts.begin(), contracts.end());
+
+	for (auto const& [file, name]: contracts)
+	{
+		string const contractName = file + ":" + name;
 
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
@@ -1272,92 +1464,115 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["abi"] = compilerStack.contractABI(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
 			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
 			contractData["userdoc"] = compilerStack.natspecUser(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
 			contractData["devdoc"] = compilerStack.natspecDev(contractName);
 
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
-		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+		// Metadata, IR, Ewasm and EVM outputs depend on the EVM version
+		auto addVersionSpecificData = [&](Json::Value& _data) {
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+				_data["metadata"] = compilerStack.metadata(contractName);
+
+			// IR
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+				_data["ir"] = compilerStack.yulIR(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+				_data["irOptimized"] = compilerStack.yulIROptimized(contractName);
+
+			// Ewasm
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+				_data["ewasm"]["wast"] = compilerStack.ewasm(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+				_data["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
+
+			// EVM
+			Json::Value evmData(Json::objectValue);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+				evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+				evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+				evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+				evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("bytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["bytecode"] = collectEVMObject(
+					compilerStack.object(contractName),
+					compilerStack.sourceMapping(contractName),
+					compilerStack.generatedSources(contractName),
+					false,
+					[&](string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.bytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("deployedBytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["deployedBytecode"] = collectEVMObject(
+					compilerStack.runtimeObject(contractName),
+					compilerStack.runtimeSourceMapping(contractName),
+					compilerStack.generatedSources(contractName, true),
+					true,
+					[&](string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.deployedBytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+			if (!evmData.empty())
+				_data["evm"] = evmData;
+		};
+		addVersionSpecificData(contractData);
 
-		if (!contractData.empty())
+		if (compilationSuccess)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			for (langutil::EVMVersion const& evmVersion: compilerStack.evmVersions())
+				if (evmVersion != _inputsAndSettings.evmVersion)
+				{
+					compilerStack.selectEVMVersion(evmVersion);
+					Json::Value versionData(Json::objectValue);
+					addVersionSpecificData(versionData);
+					if (!versionData.empty())
+						contractData["additionalEVMVersions"][evmVersion.name()] = std::move(versionData);
+				}
+			compilerStack.selectEVMVersion(_inputsAndSettings.evmVersion);
 		}
+
+		if (!contractData.empty())
+			_output.contract(file, name, std::move(contractData));
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	unsigned sourceIndex = 0;
+	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
+		for (string const& sourceName: compilerStack.sourceNames())
+			_output.source(
+				sourceName,
+				sourceIndex++,
+				compilerStack,
+				isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental)
+			);
+
+	_output.finish();
 }
 
 
@@ -1503,64 +1718,95 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	JsonOutputSink output;
+	try
+	{
+		compile(_input, output);
+	}
+	catch (...)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+	}
+	return std::move(output.output());
+}
+
+void StandardCompiler::compile(Json::Value const& _input, OutputSink& _output)
+{
+	if (m_clearYulStrings)
+		YulStringRepository::reset();
 
 	try
 	{
 		auto parsed = parseInput(_input);
 		if (std::holds_alternative<Json::Value>(parsed))
-			return std::get<Json::Value>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			_output.complete(std::get<Json::Value>(std::move(parsed)));
+		else if (InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed)); settings.language == "Solidity")
+			compileSolidity(std::move(settings), _output);
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+			_output.complete(compileYul(std::move(settings)));
 		else
-			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+			_output.complete(formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language."));
 	}
 	catch (Json::LogicError const& _exception)
 	{
-		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+		_output.complete(formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what()));
 	}
 	catch (Json::RuntimeError const& _exception)
 	{
-		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+		_output.complete(formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what()));
 	}
 	catch (util::Exception const& _exception)
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+		_output.complete(formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception)));
 	}
 	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		_output.complete(formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information()));
 	}
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
+{
+	string output;
+	try
+	{
+		StringAppendBuffer buffer(output);
+		ostream stream(&buffer);
+		compile(_input, stream);
+	}
+	catch (...)
+	{
+		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+	}
+	return output;
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
 {
 	Json::Value input;
 	string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonPrint(formatFatalError("JSONError", errors), m_jsonPrintingFormat);
+		{
+			_output << util::jsonPrint(formatFatalError("JSONError", errors), m_jsonPrintingFormat);
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
-
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		StreamOutputSink output(_output, m_jsonPrintingFormat);
+		compile(input, output);
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
 
@@ -29,6 +29,7 @@
 #include <liblangutil/DebugInfoSelection.h>
 
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -62,11 +63,94 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as the above, but writes the serialized JSON output to @a _output.
+	/// The output of a Solidity compilation is written contract by contract and source by source
+	/// while it is produced, so that it is never held in memory as a whole. ``errors`` is written
+	/// last, so that internal errors that occur after writing the output has started can still be
+	/// added to it.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Determines whether the Yul string repository is cleared at the start of every compilation
+	/// (the default). Long-running processes can keep the strings between compilations
+	/// and clear the repository themselves once it grows too large.
+	void setClearYulStrings(bool _clearYulStrings = true) { m_clearYulStrings = _clearYulStrings; }
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 	);
 
+	/**
+	 * Receives the output of a compilation.
+	 * The output of a Solidity compilation is passed piece by piece: auxiliaryInputRequested(),
+	 * errors(), contract() for every contract sorted by file and contract name, source() for every
+	 * source in the order of the source indices and finally finish().
+	 */
+	class OutputSink
+	{
+	public:
+		virtual ~OutputSink() = default;
+
+		/// Receives the complete output. Used for results that are not produced piece by piece,
+		/// including fatal errors, which can also occur after some of the pieces have been passed.
+		virtual void complete(Json::Value _output) = 0;
+		virtual void auxiliaryInputRequested(Json::Value _auxiliaryInput) = 0;
+		virtual void errors(Json::Value _errors) = 0;
+		/// Receives the (non-empty) output for contract @a _name in source @a _file.
+		virtual void contract(std::string const& _file, std::string const& _name, Json::Value _contractData) = 0;
+		/// Receives the output for source @a _sourceName, including its AST if @a _withAST is true.
+		virtual void source(std::string const& _sourceName, unsigned _id, CompilerStack const& _compilerStack, bool _withAST) = 0;
+		virtual void finish() = 0;
+	};
+
+	/// Collects the output in a Json::Value.
+	class JsonOutputSink: public OutputSink
+	{
+	public:
+		void complete(Json::Value _output) override { m_output = std::move(_output); }
+		void auxiliaryInputRequested(Json::Value _auxiliaryInput) override;
+		void errors(Json::Value _errors) override;
+		void contract(std::string const& _file, std::string const& _name, Json::Value _contractData) override;
+		void source(std::string const& _sourceName, unsigned _id, CompilerStack const& _compilerStack, bool _withAST) override;
+		void finish() override;
+
+		Json::Value& output() { return m_output; }
+
+	private:
+		Json::Value m_output = Json::objectValue;
+	};
+
+	/// Writes the output to a stream as soon as possible. The errors are kept until the end,
+	/// so that a single ``errors`` member can be written even if an internal error occurs late.
+	class StreamOutputSink: public OutputSink
+	{
+	public:
+		StreamOutputSink(std::ostream& _stream, util::JsonFormat const& _format): m_writer(_stream, _format) {}
+
+		void complete(Json::Value _output) override;
+		void auxiliaryInputRequested(Json::Value _auxiliaryInput) override;
+		void errors(Json::Value _errors) override;
+		void contract(std::string const& _file, std::string const& _name, Json::Value _contractData) override;
+		void source(std::string const& _sourceName, unsigned _id, CompilerStack const& _compilerStack, bool _withAST) override;
+		void finish() override;
+
+	private:
+		void start();
+		void startSources();
+		/// Closes all open members and writes the collected errors. Ends the output.
+		void end();
+
+		util::JsonStreamWriter m_writer;
+		bool m_started = false;
+		bool m_contractsOpen = false;
+		std::optional<std::string> m_currentFile;
+		Json::Value m_errors = Json::arrayValue;
+		bool m_sourcesOpen = false;
+		bool m_ended = false;
+	};
+
+	/// Compiles according to @a _input and passes the output to @a _output.
+	void compile(Json::Value const& _input, OutputSink& _output);
+
 private:
 	struct InputsAndSettings
 	{
@@ -77,6 +161,7 @@ private:
 		std::map<std::string, std::string> sources;
 		std::map<util::h256, std::string> smtLib2Responses;
 		langutil::EVMVersion evmVersion;
+		std::vector<langutil::EVMVersion> additionalEVMVersions;
 		std::vector<ImportRemapper::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
@@ -93,12 +178,14 @@ private:
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, OutputSink& _output);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	bool m_clearYulStrings = true;
 };
 
 }
@@ -0,0 +1,144 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/AnalysisSnapshot.h>
+
+#include <libsolidity/analysis/GlobalContext.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+
+AnalysisSnapshot::AnalysisSnapshot():
+	m_fileRepository("/" /* basePath */)
+{
+}
+
+AnalysisSnapshot::AnalysisSnapshot(CompilerStack const& _compilerStack, FileRepository _fileRepository):
+	m_fileRepository(move(_fileRepository)),
+	m_globalContext(_compilerStack.globalContext())
+{
+	solAssert(_compilerStack.state() >= CompilerStack::AnalysisPerformed);
+	for (string const& sourceUnitName: _compilerStack.sourceNames())
+	{
+		Source& source = m_sources[sourceUnitName];
+		source.charStream = _compilerStack.sharedCharStream(sourceUnitName);
+		source.ast = _compilerStack.sharedAST(sourceUnitName);
+		index(source);
+	}
+}
+
+SourceUnit const* AnalysisSnapshot::ast(string const& _sourceUnitName) const
+{
+	if (Source const* source = util::valueOrNullptr(m_sources, _sourceUnitName))
+		return source->ast.get();
+	return nullptr;
+}
+
+CharStream const& AnalysisSnapshot::charStream(string const& _sourceUnitName) const
+{
+	Source const* source = util::valueOrNullptr(m_sources, _sourceUnitName);
+	solAssert(source, "Unknown source: " + _sourceUnitName);
+	return *source->charStream;
+}
+
+ASTNode const* AnalysisSnapshot::innermostNode(string const& _sourceUnitName, int _offset) const
+{
+	Source const* source = util::valueOrNullptr(m_sources, _sourceUnitName);
+	if (!source)
+		return nullptr;
+
+	vector<IndexedNode> const& nodes = source->nodes;
+	auto it = upper_bound(
+		nodes.begin(),
+		nodes.end(),
+		_offset,
+		[](int _position, IndexedNode const& _node) { return _position < _node.start; }
+	);
+	if (it == nodes.begin())
+		return nullptr;
+
+	// Every node containing the offset starts at or before it and, since the locations are nested,
+	// contains the last node that does so. The innermost one is thus that node or one of its parents.
+	size_t index = static_cast<size_t>(it - nodes.begin()) - 1;
+	while (index != noParent && nodes[index].end <= _offset)
+		index = nodes[index].parent;
+	return index == noParent ? nullptr : nodes[index].node;
+}
+
+vector<ASTNode const*> const& AnalysisSnapshot::references(Declaration const& _declaration) const
+{
+	static vector<ASTNode const*> const noReferences;
+	if (auto const* references = util::valueOrNullptr(m_references, &_declaration))
+		return *references;
+	return noReferences;
+}
+
+void AnalysisSnapshot::index(Source& _source)
+{
+	if (!_source.ast)
+		return;
+
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) -> bool
+		{
+			// Like locateInnermostASTNode(), skip nodes without a location together with their children.
+			if (!_node.location().hasText())
+				return false;
+			_source.nodes.push_back({_node.location().start, _node.location().end, &_node, noParent});
+
+			Declaration const* declaration = nullptr;
+			if (auto const* identifier = dynamic_cast<Identifier const*>(&_node))
+				declaration = identifier->annotation().referencedDeclaration;
+			else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+				declaration = memberAccess->annotation().referencedDeclaration;
+			else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(&_node))
+				declaration = identifierPath->annotation().referencedDeclaration;
+			if (declaration)
+				m_references[declaration].push_back(&_node);
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	_source.ast->accept(visitor);
+
+	// The visitor produces the nodes in pre-order, so a stable sort keeps parents
+	// in front of children with the same location.
+	vector<IndexedNode>& nodes = _source.nodes;
+	stable_sort(nodes.begin(), nodes.end(), [](IndexedNode const& _a, IndexedNode const& _b) {
+		return _a.start < _b.start || (_a.start == _b.start && _a.end > _b.end);
+	});
+
+	// The nodes that may still contain the next node, outermost first.
+	vector<size_t> enclosing;
+	for (size_t index = 0; index < nodes.size(); ++index)
+	{
+		while (!enclosing.empty() && nodes[enclosing.back()].end < nodes[index].end)
+			enclosing.pop_back();
+		if (!enclosing.empty())
+			nodes[index].parent = enclosing.back();
+		enclosing.push_back(index);
+	}
+}
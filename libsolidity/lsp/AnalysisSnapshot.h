@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/lsp/FileRepository.h>
+
+#include <liblangutil/CharStreamProvider.h>
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::frontend
+{
+class ASTNode;
+class CompilerStack;
+class Declaration;
+class GlobalContext;
+class SourceUnit;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Immutable view of the sources and ASTs of a compilation that reached the analysis phase.
+ *
+ * It shares ownership of the ASTs, the character streams and the global context with the
+ * compiler stack, so that it stays valid while the compiler stack is reset and compiles the
+ * next version of the sources on another thread. Only the AST structure and the declarations
+ * referenced from annotations may be used: types are owned by the TypeProvider singleton and
+ * are invalidated by the next compilation.
+ *
+ * The snapshot indexes the ASTs once, so that navigation requests do not have to walk them:
+ *  - The nodes of every source are sorted by their locations. Since the location of a node
+ *    covers the locations of its children, the locations are nested and form a forest, in
+ *    which the innermost node containing an offset is found by a binary search for the last
+ *    node starting at or before it, followed by a walk towards the roots.
+ *  - All identifiers, member accesses and identifier paths are indexed by the declaration
+ *    they reference, across all sources.
+ */
+class AnalysisSnapshot: public langutil::CharStreamProvider
+{
+public:
+	/// Creates an empty snapshot, used until the first analysis has finished.
+	AnalysisSnapshot();
+	/// Creates a snapshot of the sources of @a _compilerStack, which has to have performed analysis.
+	AnalysisSnapshot(frontend::CompilerStack const& _compilerStack, FileRepository _fileRepository);
+
+	/// @returns the file repository the analysed sources were read from.
+	FileRepository const& fileRepository() const noexcept { return m_fileRepository; }
+	/// @returns the AST of the given source or nullptr if the source was not analysed.
+	frontend::SourceUnit const* ast(std::string const& _sourceUnitName) const;
+	langutil::CharStream const& charStream(std::string const& _sourceUnitName) const override;
+
+	/// @returns the innermost node of the given source whose location contains @a _offset
+	/// or nullptr if there is none. Same as locateInnermostASTNode(), but without visiting the AST.
+	frontend::ASTNode const* innermostNode(std::string const& _sourceUnitName, int _offset) const;
+	/// @returns all identifiers, member accesses and identifier paths of all sources that
+	/// reference @a _declaration, in the order of the sources and of their locations.
+	std::vector<frontend::ASTNode const*> const& references(frontend::Declaration const& _declaration) const;
+
+private:
+	static size_t constexpr noParent = std::numeric_limits<size_t>::max();
+
+	struct IndexedNode
+	{
+		int start;
+		int end;
+		frontend::ASTNode const* node;
+		/// Index of the innermost other node whose location contains the one of this node, or noParent.
+		size_t parent;
+	};
+
+	struct Source
+	{
+		std::shared_ptr<langutil::CharStream const> charStream;
+		std::shared_ptr<frontend::SourceUnit const> ast;
+		/// The nodes with a location, sorted by start offset and, on ties, with the outer nodes first.
+		std::vector<IndexedNode> nodes;
+	};
+
+	/// Indexes the nodes of @a _source and adds the references they contain to m_references.
+	void index(Source& _source);
+
+	FileRepository m_fileRepository;
+	std::map<std::string, Source> m_sources;
+	std::unordered_map<frontend::Declaration const*, std::vector<frontend::ASTNode const*>> m_references;
+	/// Owns the magic variables referenced from the ASTs.
+	std::shared_ptr<frontend::GlobalContext const> m_globalContext;
+};
+
+}
@@ -55,7 +55,7 @@ void GotoDefinition::operator()(MessageID _id, Json::Value const& _args)
 	else if (auto const* importDirective = dynamic_cast<ImportDirective const*>(sourceNode))
 	{
 		auto const& path = *importDirective->annotation().absolutePath;
-		if (fileRepository().sourceUnits().count(path))
+		if (analysis().ast(path))
 			locations.emplace_back(SourceLocation{0, 0, make_shared<string const>(path)});
 	}
 
@@ -33,21 +33,14 @@ using namespace std;
 
 Json::Value HandlerBase::toRange(SourceLocation const& _location) const
 {
-	if (!_location.hasText())
-		return toJsonRange({}, {});
-
-	solAssert(_location.sourceName, "");
-	langutil::CharStream const& stream = charStreamProvider().charStream(*_location.sourceName);
-	LineColumn start = stream.translatePositionToLineColumn(_location.start);
-	LineColumn end = stream.translatePositionToLineColumn(_location.end);
-	return toJsonRange(start, end);
+	return toJsonRange(charStreamProvider(), _location);
 }
 
 Json::Value HandlerBase::toJson(SourceLocation const& _location) const
 {
 	solAssert(_location.sourceName);
 	Json::Value item = Json::objectValue;
-	item["uri"] = fileRepository().sourceUnitNameToUri(*_location.sourceName);
+	item["uri"] = analysis().fileRepository().sourceUnitNameToUri(*_location.sourceName);
 	item["range"] = toRange(_location);
 	return item;
 }
@@ -56,7 +49,7 @@ pair<string, LineColumn> HandlerBase::extractSourceUnitNameAndLineColumn(Json::V
 {
 	string const uri = _args["textDocument"]["uri"].asString();
 	string const sourceUnitName = fileRepository().uriToSourceUnitName(uri);
-	if (!fileRepository().sourceUnits().count(sourceUnitName))
+	if (!fileRepository().sourceUnits().count(sourceUnitName) && !analysis().ast(sourceUnitName))
 		BOOST_THROW_EXCEPTION(
 			RequestError(ErrorCode::RequestFailed) <<
 			errinfo_comment("Unknown file: " + uri)
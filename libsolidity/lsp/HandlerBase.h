@@ -46,7 +46,10 @@ public:
 	std::pair<std::string, langutil::LineColumn> extractSourceUnitNameAndLineColumn(Json::Value const& _params) const;
 
 	langutil::CharStreamProvider const& charStreamProvider() const noexcept { return m_server.charStreamProvider(); }
+	/// @returns the files as currently edited by the client.
 	FileRepository const& fileRepository() const noexcept { return m_server.fileRepository(); }
+	/// @returns the snapshot of the last analysis, which all AST nodes and locations refer to.
+	AnalysisSnapshot const& analysis() const noexcept { return m_server.analysis(); }
 	Transport& client() const noexcept { return m_server.client(); }
 
 protected:
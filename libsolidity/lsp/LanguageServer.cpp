@@ -26,6 +26,7 @@
 
 // LSP feature implementations
 #include <libsolidity/lsp/GotoDefinition.h>
+#include <libsolidity/lsp/References.h>
 
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
@@ -81,21 +82,35 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/didChange", bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
 		{"textDocument/implementation", GotoDefinition(*this) },
+		{"textDocument/references", References(*this) },
 		{"workspace/didChangeConfiguration", bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_analysis{make_shared<AnalysisSnapshot const>()},
+	m_latestAnalysis{m_analysis},
+	m_compiledFiles("/" /* basePath */),
+	m_compilerStack{m_compiledFiles.reader()}
 {
+	m_compilationThread = thread(&LanguageServer::runCompilations, this);
 }
 
-Json::Value LanguageServer::toRange(SourceLocation const& _location)
+LanguageServer::~LanguageServer()
 {
-	return HandlerBase(*this).toRange(_location);
+	stopCompilationThread();
 }
 
-Json::Value LanguageServer::toJson(SourceLocation const& _location)
+Json::Value LanguageServer::toRange(SourceLocation const& _location) const
 {
-	return HandlerBase(*this).toJson(_location);
+	return toJsonRange(m_compilerStack, _location);
+}
+
+Json::Value LanguageServer::toJson(SourceLocation const& _location) const
+{
+	solAssert(_location.sourceName);
+	Json::Value item = Json::objectValue;
+	item["uri"] = m_compiledFiles.sourceUnitNameToUri(*_location.sourceName);
+	item["range"] = toRange(_location);
+	return item;
 }
 
 void LanguageServer::changeConfiguration(Json::Value const& _settings)
@@ -103,7 +118,7 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	m_settingsObject = _settings;
 }
 
-void LanguageServer::compile()
+void LanguageServer::scheduleCompilation()
 {
 	// For files that are not open, we have to take changes on disk into account,
 	// so we just remove all non-open files.
@@ -119,19 +134,93 @@ void LanguageServer::compile()
 
 	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	{
+		lock_guard<mutex> lock(m_compilationMutex);
+		m_scheduledFiles = m_fileRepository;
+		++m_compilationGeneration;
+	}
+	m_compilationScheduled.notify_one();
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+void LanguageServer::runCompilations()
 {
-	compile();
+	unique_lock<mutex> lock(m_compilationMutex);
+	while (true)
+	{
+		m_compilationScheduled.wait(lock, [&] { return m_stopCompilation || m_scheduledFiles; });
+		if (m_stopCompilation)
+			return;
+
+		// Only start compiling once the client stopped sending changes, e.g. while the user is typing.
+		uint64_t generation = m_compilationGeneration;
+		while (m_compilationScheduled.wait_for(lock, compilationDelay, [&] { return m_stopCompilation || superseded(generation); }))
+		{
+			if (m_stopCompilation)
+				return;
+			generation = m_compilationGeneration;
+		}
+
+		FileRepository files = move(*m_scheduledFiles);
+		m_scheduledFiles.reset();
+		lock.unlock();
+		compile(move(files), generation);
+		lock.lock();
+	}
+}
+
+void LanguageServer::compile(FileRepository _files, uint64_t _generation)
+{
+	try
+	{
+		m_compiledFiles = move(_files);
+		m_compilerStack.reset(false);
+		m_compilerStack.setSources(m_compiledFiles.sourceUnits());
+
+		// Equivalent to m_compilerStack.compile(CompilerStack::State::AnalysisPerformed),
+		// but abandons the compilation between the phases once a newer one was scheduled.
+		bool const parsed = m_compilerStack.parse();
+		if (superseded(_generation))
+			return;
+		if (parsed)
+			m_compilerStack.analyze();
+		if (superseded(_generation))
+			return;
+
+		if (m_compilerStack.state() >= CompilerStack::AnalysisPerformed)
+		{
+			// Published before the diagnostics, so that requests sent by the client
+			// in reaction to the diagnostics already see the new analysis.
+			auto analysis = make_shared<AnalysisSnapshot const>(m_compilerStack, m_compiledFiles);
+			lock_guard<mutex> lock(m_compilationMutex);
+			m_latestAnalysis = move(analysis);
+		}
 
+		publishDiagnostics();
+	}
+	catch (...)
+	{
+		m_client.error({}, ErrorCode::InternalError, "Unhandled exception during compilation: "s + boost::current_exception_diagnostic_information());
+	}
+}
+
+void LanguageServer::stopCompilationThread()
+{
+	{
+		lock_guard<mutex> lock(m_compilationMutex);
+		m_stopCompilation = true;
+		++m_compilationGeneration;
+	}
+	m_compilationScheduled.notify_one();
+	if (m_compilationThread.joinable())
+		m_compilationThread.join();
+}
+
+void LanguageServer::publishDiagnostics()
+{
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	map<string, Json::Value> diagnosticsBySourceUnit;
-	for (string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+	for (string const& sourceUnitName: m_compiledFiles.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
 	for (string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
@@ -176,7 +265,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
 		Json::Value params;
-		params["uri"] = m_fileRepository.sourceUnitNameToUri(sourceUnitName);
+		params["uri"] = m_compiledFiles.sourceUnitNameToUri(sourceUnitName);
 		if (!diagnostics.empty())
 			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = move(diagnostics);
@@ -195,6 +284,11 @@ bool LanguageServer::run()
 			if (!jsonMessage)
 				continue;
 
+			{
+				lock_guard<mutex> lock(m_compilationMutex);
+				m_analysis = m_latestAnalysis;
+			}
+
 			if ((*jsonMessage)["method"].isString())
 			{
 				string const methodName = (*jsonMessage)["method"].asString();
@@ -217,6 +311,7 @@ bool LanguageServer::run()
 			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 		}
 	}
+	stopCompilationThread();
 	return m_state == State::ExitRequested;
 }
 
@@ -264,6 +359,7 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 	replyArgs["serverInfo"]["version"] = string(VersionNumber);
 	replyArgs["capabilities"]["definitionProvider"] = true;
 	replyArgs["capabilities"]["implementationProvider"] = true;
+	replyArgs["capabilities"]["referencesProvider"] = true;
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 
@@ -307,7 +403,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.insert(uri);
 	m_fileRepository.setSourceByUri(uri, move(text));
-	compileAndUpdateDiagnostics();
+	scheduleCompilation();
 }
 
 void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
@@ -348,7 +444,7 @@ void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
 		m_fileRepository.setSourceByUri(uri, move(text));
 	}
 
-	compileAndUpdateDiagnostics();
+	scheduleCompilation();
 }
 
 void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
@@ -364,20 +460,17 @@ void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.erase(uri);
 
-	compileAndUpdateDiagnostics();
+	scheduleCompilation();
 }
 
 ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisPerformed)
-		return nullptr;
-
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+	if (!m_analysis->ast(_sourceUnitName))
 		return nullptr;
 
 	if (optional<int> sourcePos =
-		m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos))
-		return locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName));
+		m_analysis->charStream(_sourceUnitName).translateLineColumnToPosition(_filePos))
+		return m_analysis->innermostNode(_sourceUnitName, *sourcePos);
 	else
 		return nullptr;
 }
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolidity/lsp/AnalysisSnapshot.h>
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -24,10 +25,16 @@
 
 #include <json/value.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace solidity::lsp
@@ -39,15 +46,23 @@ enum class ErrorCode;
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * Compilation runs on a separate thread, so that the message loop is never blocked by it.
+ * Changes to the sources only schedule a compilation, which starts once no further change
+ * arrived for a short delay. A compilation that is superseded by a newer change is abandoned
+ * at the next phase boundary and its results are discarded. Navigation requests are answered
+ * from the snapshot of the last compilation that reached the analysis phase.
  */
 class LanguageServer
 {
 public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
+	~LanguageServer();
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
-	void compileAndUpdateDiagnostics();
+	/// Schedules a re-compilation of the open files, after which the diagnostics
+	/// pushed to the client are updated.
+	void scheduleCompilation();
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
 	///
@@ -57,10 +72,13 @@ public:
 	/// @return boolean indicating normal or abnormal termination.
 	bool run();
 
+	/// @returns the files as currently edited by the client.
 	FileRepository& fileRepository() noexcept { return m_fileRepository; }
 	Transport& client() noexcept { return m_client; }
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	langutil::CharStreamProvider const& charStreamProvider() const noexcept { return m_compilerStack; }
+	/// @returns the snapshot of the last analysis, which stays the same while a message is handled.
+	AnalysisSnapshot const& analysis() const noexcept { return *m_analysis; }
+	langutil::CharStreamProvider const& charStreamProvider() const noexcept { return *m_analysis; }
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
@@ -77,12 +95,27 @@ private:
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json::Value const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
+	/// Runs the scheduled compilations until stopCompilationThread() is called.
+	/// Executed on m_compilationThread.
+	void runCompilations();
+	/// Compiles @a _files until after the analysis phase and, unless it was superseded by
+	/// a newer compilation request, publishes the snapshot and the diagnostics.
+	/// Executed on m_compilationThread.
+	void compile(FileRepository _files, uint64_t _generation);
+	/// Sends the diagnostics of the last compilation to the client.
+	/// Executed on m_compilationThread.
+	void publishDiagnostics();
+	/// @returns true if a compilation with a generation newer than @a _generation was requested.
+	bool superseded(uint64_t _generation) const { return m_compilationGeneration != _generation; }
+	/// Finishes the running compilation, if any, and terminates the compilation thread.
+	void stopCompilationThread();
 	using MessageHandler = std::function<void(MessageID, Json::Value const&)>;
 
-	Json::Value toRange(langutil::SourceLocation const& _location);
-	Json::Value toJson(langutil::SourceLocation const& _location);
+	Json::Value toRange(langutil::SourceLocation const& _location) const;
+	Json::Value toJson(langutil::SourceLocation const& _location) const;
+
+	/// Time without further changes after which a scheduled compilation starts.
+	static constexpr std::chrono::milliseconds compilationDelay{50};
 
 	// LSP related member fields
 
@@ -94,14 +127,35 @@ private:
 
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
-	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
-	std::set<std::string> m_nonemptyDiagnostics;
 	FileRepository m_fileRepository;
-
-	frontend::CompilerStack m_compilerStack;
+	/// Snapshot used while handling the current message.
+	std::shared_ptr<AnalysisSnapshot const> m_analysis;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
+
+	// Members shared with the compilation thread, guarded by m_compilationMutex.
+
+	std::mutex m_compilationMutex;
+	std::condition_variable m_compilationScheduled;
+	/// Contents of the open files to be compiled next, if a compilation is pending.
+	std::optional<FileRepository> m_scheduledFiles;
+	/// Snapshot of the last compilation that reached the analysis phase.
+	std::shared_ptr<AnalysisSnapshot const> m_latestAnalysis;
+	bool m_stopCompilation = false;
+	/// Incremented with every scheduled compilation. Only modified while holding
+	/// m_compilationMutex, but also read by the compilation thread without it.
+	std::atomic<uint64_t> m_compilationGeneration = 0;
+
+	// Members only accessed by the compilation thread.
+
+	/// Files of the running compilation, including the ones loaded from disk.
+	FileRepository m_compiledFiles;
+	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
+	std::set<std::string> m_nonemptyDiagnostics;
+	frontend::CompilerStack m_compilerStack;
+
+	std::thread m_compilationThread;
 };
 
 }
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/References.h>
+#include <libsolidity/lsp/Transport.h> // for RequestError
+#include <libsolidity/lsp/Utils.h>
+#include <libsolidity/ast/AST.h>
+
+#include <string>
+#include <vector>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+namespace
+{
+
+/// @returns the location of the name of the declaration referenced by @a _reference.
+SourceLocation referenceLocation(ASTNode const& _reference)
+{
+	SourceLocation location = _reference.location();
+	// Member accesses and identifier paths end in the name of the referenced declaration.
+	string const* name = nullptr;
+	if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_reference))
+		name = &memberAccess->memberName();
+	else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(&_reference))
+		name = &identifierPath->path().back();
+	if (name && location.end - location.start >= static_cast<int>(name->size()))
+		location.start = location.end - static_cast<int>(name->size());
+	return location;
+}
+
+}
+
+void References::operator()(MessageID _id, Json::Value const& _args)
+{
+	auto const [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
+
+	ASTNode const* sourceNode = m_server.astNodeAtSourceLocation(sourceUnitName, lineColumn);
+
+	Declaration const* declaration = dynamic_cast<Declaration const*>(sourceNode);
+	if (auto const* expression = dynamic_cast<Expression const*>(sourceNode))
+		declaration = referencedDeclaration(expression);
+	else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(sourceNode))
+		declaration = identifierPath->annotation().referencedDeclaration;
+
+	vector<SourceLocation> locations;
+	if (declaration)
+	{
+		if (_args["context"]["includeDeclaration"].asBool())
+			if (auto location = declarationLocation(declaration))
+				locations.emplace_back(move(location.value()));
+		for (ASTNode const* reference: analysis().references(*declaration))
+			locations.emplace_back(referenceLocation(*reference));
+	}
+
+	Json::Value reply = Json::arrayValue;
+	for (SourceLocation const& location: locations)
+		reply.append(toJson(location));
+	client().reply(_id, reply);
+}
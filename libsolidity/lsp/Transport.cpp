@@ -136,6 +136,7 @@ void Transport::send(Json::Value _json, MessageID _id)
 	// Trailing CRLF only for easier readability.
 	string const jsonString = solidity::util::jsonCompactPrint(_json);
 
+	lock_guard<mutex> lock(m_sendMutex);
 	writeBytes(fmt::format("Content-Length: {}\r\n\r\n", jsonString.size()));
 	writeBytes(jsonString);
 	flushOutput();
@@ -21,9 +21,11 @@
 
 #include <json/value.h>
 
+#include <atomic>
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -104,7 +106,10 @@ public:
 	void setTrace(TraceValue _value) noexcept { m_logTrace = _value; }
 
 private:
-	TraceValue m_logTrace = TraceValue::Off;
+	std::atomic<TraceValue> m_logTrace = TraceValue::Off;
+	/// Serializes outgoing messages, which are sent from the message loop as well as
+	/// from the language server's compilation thread.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
@@ -127,7 +132,7 @@ protected:
 
 	/// Sends an arbitrary raw message to the client.
 	///
-	/// Used by the notify/reply/error function family.
+	/// Used by the notify/reply/error function family, which may be called from any thread.
 	virtual void send(Json::Value _message, MessageID _id = Json::nullValue);
 };
 
@@ -57,6 +57,18 @@ Json::Value toJsonRange(LineColumn const& _start, LineColumn const& _end)
 	return json;
 }
 
+Json::Value toJsonRange(CharStreamProvider const& _charStreamProvider, SourceLocation const& _location)
+{
+	if (!_location.hasText())
+		return toJsonRange({}, {});
+
+	solAssert(_location.sourceName, "");
+	CharStream const& stream = _charStreamProvider.charStream(*_location.sourceName);
+	LineColumn start = stream.translatePositionToLineColumn(_location.start);
+	LineColumn end = stream.translatePositionToLineColumn(_location.end);
+	return toJsonRange(start, end);
+}
+
 Declaration const* referencedDeclaration(Expression const* _expression)
 {
 	if (auto const* identifier = dynamic_cast<Identifier const*>(_expression))
@@ -48,6 +48,13 @@ std::optional<langutil::LineColumn> parseLineColumn(Json::Value const& _lineColu
 Json::Value toJson(langutil::LineColumn const& _pos);
 Json::Value toJsonRange(langutil::LineColumn const& _start, langutil::LineColumn const& _end);
 
+/// @returns the LSP Range object of @a _location, using the source provided by @a _charStreamProvider
+/// for translating the offsets into line and column numbers.
+Json::Value toJsonRange(
+	langutil::CharStreamProvider const& _charStreamProvider,
+	langutil::SourceLocation const& _location
+);
+
 /// @returns the source location given a source unit name and an LSP Range object,
 /// or nullopt on failure.
 std::optional<langutil::SourceLocation> parsePosition(
@@ -72,7 +72,7 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.trackNode(make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...));
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -156,6 +156,16 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	solAssert(m_trackNodes, "");
+	for (weak_ptr<ASTNode> const& trackedNode: m_trackedNodes)
+		if (ASTPointer<ASTNode> node = trackedNode.lock())
+			node->shiftID(_offset);
+	m_trackedNodes.clear();
+	m_currentNodeID += _offset;
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, vector<Token> const& _tokens, vector<string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -1366,7 +1376,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, move(flags), block);
+	return trackNode(make_shared<InlineAssembly>(nextID(), location, _docString, dialect, move(flags), block));
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
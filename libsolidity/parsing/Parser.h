@@ -49,6 +49,16 @@ public:
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
+	/// Makes the parser keep track of all nodes it creates from now on,
+	/// so that their IDs can be changed later using shiftNodeIDs().
+	void enableNodeTracking() { m_trackNodes = true; }
+	/// @returns the number of node IDs assigned so far.
+	int64_t nodeIDCount() const { return m_currentNodeID; }
+	/// Adds @a _offset to the IDs of all tracked nodes that are still alive and to the ID counter.
+	/// Used to number the nodes of sources parsed by independent parsers as if they had
+	/// been parsed one after the other by a single parser.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -188,6 +198,14 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Records @a _node for shiftNodeIDs() if node tracking is enabled.
+	template <class NodeType>
+	ASTPointer<NodeType> trackNode(ASTPointer<NodeType> _node)
+	{
+		if (m_trackNodes)
+			m_trackedNodes.emplace_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -217,6 +235,10 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_trackNodes = false;
+	/// All nodes created while node tracking was enabled. Nodes dropped during error
+	/// recovery are not part of any AST, so weak references suffice.
+	std::vector<std::weak_ptr<ASTNode>> m_trackedNodes;
 };
 
 }
@@ -19,9 +19,9 @@
 #include <libsolutil/IpfsHash.h>
 
 #include <libsolutil/Exceptions.h>
-#include <libsolutil/picosha2.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Numeric.h>
+#include <libsolutil/SHA256.h>
 
 using namespace std;
 using namespace solidity;
@@ -46,9 +46,10 @@ bytes encodeByteArray(bytes const& _data)
 	return bytes{0x0a} + varintEncoding(_data.size()) + _data;
 }
 
-bytes encodeHash(bytes const& _data)
+/// Multihash: sha2-256, 256 bits
+bytes encodeHash(h256 const& _sha256)
 {
-	return bytes{0x12, 0x20} + picosha2::hash256(_data);
+	return bytes{0x12, 0x20} + _sha256.asBytes();
 }
 
 bytes encodeLinkData(bytes const& _data)
@@ -110,7 +111,7 @@ Chunk combineLinks(Chunks& _links)
 	bytes blockData = data + encodeByteArray(bytes{0x08, 0x02, 0x18} + varintEncoding(chunk.size) + lengths);
 
 	chunk.blockSize += blockData.size();
-	chunk.hash = encodeHash(blockData);
+	chunk.hash = encodeHash(sha256(blockData));
 
 	return chunk;
 }
@@ -153,7 +154,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string const& _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -163,41 +164,43 @@ bytes solidity::util::ipfsHash(string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
+		size_t const chunkOffset = chunkIndex * maxChunkSize;
+		// Hashed in place, the data of a chunk is never copied.
+		bytesConstRef chunkBytes = bytesConstRef(_data).cropped(
+			chunkOffset,
+			min(maxChunkSize, _data.length() - chunkOffset)
 		);
 
 		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
 
-		bytes protobufEncodedData;
+		// The protobuf encoded data is the chunk surrounded by protobufPrefix and protobufSuffix.
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
+		bytes protobufPrefix{0x08, 0x02};
 		if (!chunkBytes.empty())
 		{
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
+			protobufPrefix += bytes{0x12};
+			protobufPrefix += lengthAsVarint;
 		}
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes protobufSuffix = bytes{0x18} + lengthAsVarint;
+		size_t const protobufSize = protobufPrefix.size() + chunkBytes.size() + protobufSuffix.size();
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
+		bytes blockPrefix = bytes{0x0a} + varintEncoding(protobufSize) + protobufPrefix;
 
-		// Multihash: sha2-256, 256 bits
 		allChunks.emplace_back(
-			encodeHash(blockData),
+			encodeHash(SHA256Hasher{}.update(blockPrefix).update(chunkBytes).update(protobufSuffix).digest()),
 			chunkBytes.size(),
-			blockData.size()
+			blockPrefix.size() + chunkBytes.size() + protobufSuffix.size()
 		);
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string const& _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
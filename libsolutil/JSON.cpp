@@ -22,7 +22,9 @@
 
 #include <libsolutil/JSON.h>
 
+#include <libsolutil/Assertions.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -76,6 +78,20 @@ string print(Json::Value const& _input, Json::StreamWriterBuilder const& _builde
 	return stream.str();
 }
 
+/// @returns the settings of the Json::StreamWriterBuilder that produces the format @a _format.
+map<string, Json::Value> writerSettings(JsonFormat const& _format)
+{
+	map<string, Json::Value> settings;
+	if (_format.format == JsonFormat::Pretty)
+	{
+		settings["indentation"] = string(_format.indent, ' ');
+		settings["enableYAMLCompatibility"] = true;
+	}
+	else
+		settings["indentation"] = "";
+	return settings;
+}
+
 /// Parse a JSON string (@a _input) with specified builder (@ _builder) and writes resulting JSON object to (@a _json)
 /// \param _builder CharReaderBuilder that is used to create new Json::CharReaders
 /// \param _input JSON input string
@@ -125,21 +141,176 @@ string jsonCompactPrint(Json::Value const& _input)
 
 string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 {
-	map<string, Json::Value> settings;
-	if (_format.format == JsonFormat::Pretty)
-	{
-		settings["indentation"] = string(_format.indent, ' ');
-		settings["enableYAMLCompatibility"] = true;
-	}
-	else
-		settings["indentation"] = "";
-	StreamWriterBuilder writerBuilder(settings);
+	StreamWriterBuilder writerBuilder(writerSettings(_format));
 	string result = print(_input, writerBuilder);
 	if (_format.format == JsonFormat::Pretty)
 		boost::replace_all(result, " \n", "\n");
 	return result;
 }
 
+JsonStreamWriter::JsonStreamWriter(ostream& _stream, JsonFormat const& _format):
+	m_stream(_stream),
+	m_format(_format),
+	m_scalarWriter(StreamWriterBuilder(writerSettings(_format)).newStreamWriter()),
+	m_indentation(_format.format == JsonFormat::Pretty ? string(_format.indent, ' ') : "")
+{
+}
+
+void JsonStreamWriter::beginObject()
+{
+	beginValue();
+	m_containers.push_back({true});
+}
+
+void JsonStreamWriter::endObject()
+{
+	endContainer(true);
+}
+
+void JsonStreamWriter::beginArray()
+{
+	beginValue();
+	m_containers.push_back({false});
+}
+
+void JsonStreamWriter::endArray()
+{
+	endContainer(false);
+}
+
+void JsonStreamWriter::key(string const& _key)
+{
+	assertThrow(!m_containers.empty() && m_containers.back().isObject, Exception, "Key outside of an object.");
+	Container& container = m_containers.back();
+	assertThrow(!container.expectsValue, Exception, "Missing value for the previous key.");
+	if (container.empty)
+	{
+		writeWithIndent("{");
+		m_indentString += m_indentation;
+		container.empty = false;
+	}
+	else
+		m_stream << ",";
+	writeWithIndent({});
+	m_scalarWriter->write(Json::Value(_key), &m_stream);
+	m_stream << ":";
+	// The pretty format separates keys and values by ": ", but jsonPrint removes the space
+	// in front of a line break.
+	m_pendingSpace = m_format.format == JsonFormat::Pretty;
+	container.expectsValue = true;
+}
+
+void JsonStreamWriter::value(Json::Value const& _value)
+{
+	if (_value.isObject() && !_value.empty())
+	{
+		beginObject();
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			key(it.name());
+			value(*it);
+		}
+		endObject();
+	}
+	else if (_value.isArray() && !_value.empty())
+	{
+		beginArray();
+		for (auto const& element: _value)
+			value(element);
+		endArray();
+	}
+	else
+	{
+		beginValue();
+		writeInline(_value);
+		endValue();
+	}
+}
+
+void JsonStreamWriter::endContainers(size_t _depth)
+{
+	while (m_containers.size() > _depth)
+	{
+		if (m_containers.back().expectsValue)
+			value(Json::nullValue);
+		endContainer(m_containers.back().isObject);
+	}
+}
+
+void JsonStreamWriter::beginValue()
+{
+	if (m_containers.empty())
+	{
+		m_indented = true;
+		return;
+	}
+
+	Container& container = m_containers.back();
+	if (container.isObject)
+	{
+		assertThrow(container.expectsValue, Exception, "Missing key for object member.");
+		container.expectsValue = false;
+		return;
+	}
+
+	if (container.empty)
+	{
+		writeWithIndent("[");
+		m_indentString += m_indentation;
+		container.empty = false;
+	}
+	else
+		m_stream << ",";
+	if (!m_indented && !m_indentation.empty())
+		m_stream << '\n' << m_indentString;
+	m_indented = true;
+}
+
+void JsonStreamWriter::endValue()
+{
+	if (!m_containers.empty() && !m_containers.back().isObject)
+		m_indented = false;
+}
+
+void JsonStreamWriter::endContainer(bool _isObject)
+{
+	assertThrow(!m_containers.empty() && m_containers.back().isObject == _isObject, Exception, "Mismatched end of container.");
+	Container container = m_containers.back();
+	assertThrow(!container.expectsValue, Exception, "Missing value for the last key.");
+	m_containers.pop_back();
+
+	if (container.empty)
+		writeInline(_isObject ? Json::objectValue : Json::arrayValue);
+	else
+	{
+		m_indentString.resize(m_indentString.size() - m_indentation.size());
+		writeWithIndent(_isObject ? "}" : "]");
+	}
+	endValue();
+}
+
+void JsonStreamWriter::writeInline(Json::Value const& _value)
+{
+	if (m_pendingSpace)
+		m_stream << " ";
+	m_pendingSpace = false;
+	m_scalarWriter->write(_value, &m_stream);
+}
+
+void JsonStreamWriter::writeWithIndent(string const& _text)
+{
+	if (!m_indented && !m_indentation.empty())
+	{
+		m_stream << '\n' << m_indentString;
+		m_pendingSpace = false;
+	}
+	if (m_pendingSpace)
+		m_stream << " ";
+	m_pendingSpace = false;
+	m_stream << _text;
+	m_indented = false;
+}
+
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
 {
 	static StrictModeCharReaderBuilder readerBuilder;
@@ -25,7 +25,10 @@
 
 #include <json/json.h>
 
+#include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -60,6 +63,64 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 
+/**
+ * Writes a JSON document to a stream piece by piece, without building it as a Json::Value first.
+ * The output is identical to the one of jsonPrint() for the equivalent Json::Value, provided that
+ * object members are written in the order used by Json::Value, i.e. sorted by key.
+ *
+ * Containers are opened with beginObject() / beginArray() and closed with endObject() / endArray().
+ * Every value inside an object has to be preceded by a call to key().
+ */
+class JsonStreamWriter
+{
+public:
+	JsonStreamWriter(std::ostream& _stream, JsonFormat const& _format);
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+	/// Starts a new member of the innermost object.
+	void key(std::string const& _key);
+	/// Writes the complete value @a _value.
+	void value(Json::Value const& _value);
+	/// @returns the number of open containers.
+	size_t depth() const { return m_containers.size(); }
+	/// Closes open containers until only @a _depth of them remain open.
+	/// Used to complete a document when writing it had to be aborted. A key without value gets the value null.
+	void endContainers(size_t _depth);
+
+private:
+	struct Container
+	{
+		bool isObject = false;
+		bool empty = true;
+		bool expectsValue = false;
+	};
+
+	/// Emits the separators and indentation that precede the next value.
+	void beginValue();
+	/// Updates the state after a value has been written.
+	void endValue();
+	void endContainer(bool _isObject);
+	/// Writes a scalar (or empty container) directly after the preceding token.
+	void writeInline(Json::Value const& _value);
+	/// Writes @a _text on a new line at the current indentation level.
+	void writeWithIndent(std::string const& _text);
+
+	std::ostream& m_stream;
+	JsonFormat m_format;
+	std::unique_ptr<Json::StreamWriter> m_scalarWriter;
+	std::string m_indentation;
+	std::string m_indentString;
+	std::vector<Container> m_containers;
+	/// True if the current position is already properly indented for the next value.
+	bool m_indented = true;
+	/// True if the last token was a colon after an object key in pretty mode, which is
+	/// followed by a space unless the value starts on a new line.
+	bool m_pendingSpace = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
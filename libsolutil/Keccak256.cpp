@@ -23,7 +23,6 @@
 #include <libsolutil/Keccak256.h>
 
 #include <cstdint>
-#include <cstring>
 
 using namespace std;
 
@@ -108,78 +107,75 @@ static inline void keccakf(void* state) {
 	}
 }
 
-/******** The FIPS202-defined functions. ********/
+/// Reads eight bytes as a little-endian number. Compilers turn this into a single load on
+/// little-endian machines.
+inline uint64_t loadLane(uint8_t const* _data)
+{
+	uint64_t lane = 0;
+	for (unsigned i = 0; i < 8; ++i)
+		lane |= uint64_t(_data[i]) << (8 * i);
+	return lane;
+}
 
-/*** Some helper macros. ***/
+/// Xors the byte @a _byte into the state at byte position @a _position.
+inline void absorbByte(array<uint64_t, 25>& _state, size_t _position, uint8_t _byte)
+{
+	_state[_position / 8] ^= uint64_t(_byte) << (8 * (_position % 8));
+}
 
-#define _(S) do { S } while (0)
-#define FOR(i, ST, L, S) \
-	_(for (size_t i = 0; i < L; i += ST) { S; })
-#define mkapply_ds(NAME, S)                                          \
-	static inline void NAME(uint8_t* dst,                              \
-							uint8_t const* src,                        \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
-	}
-#define mkapply_sd(NAME, S)                                          \
-	static inline void NAME(uint8_t const* src,                        \
-							uint8_t* dst,                              \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
-	}
+}
 
-mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
-mkapply_sd(setout, dst[i] = src[i])  // setout
+Keccak256Hasher& Keccak256Hasher::update(bytesConstRef _data)
+{
+	uint8_t const* data = _data.data();
+	size_t size = _data.size();
 
-#define P keccakf
-#define Plen 200
+	// Complete a partially absorbed lane byte by byte.
+	for (; size > 0 && m_blockPosition % 8 != 0; --size)
+		absorbByte(m_state, m_blockPosition++, *data++);
+	if (m_blockPosition == rate)
+	{
+		keccakf(m_state.data());
+		m_blockPosition = 0;
+	}
 
-// Fold P*F over the full blocks of an input.
-#define foldP(I, L, F) \
-	while (L >= rate) {  \
-		F(a, I, rate);     \
-		P(a);              \
-		I += rate;         \
-		L -= rate;         \
+	// Absorb whole lanes.
+	while (size >= 8)
+	{
+		m_state[m_blockPosition / 8] ^= loadLane(data);
+		m_blockPosition += 8;
+		data += 8;
+		size -= 8;
+		if (m_blockPosition == rate)
+		{
+			keccakf(m_state.data());
+			m_blockPosition = 0;
+		}
 	}
 
-/** The sponge-based hash construction. **/
-inline void hash(
-	uint8_t* out,
-	size_t outlen,
-	uint8_t const* in,
-	size_t inlen,
-	size_t rate,
-	uint8_t delim
-)
-{
-	uint8_t a[Plen] = {0};
-	// Absorb input.
-	foldP(in, inlen, xorin);
-	// Xor in the DS and pad frame.
-	a[inlen] ^= delim;
-	a[rate - 1] ^= 0x80;
-	// Xor in the last block.
-	xorin(a, in, inlen);
-	// Apply P
-	P(a);
-	// Squeeze output.
-	foldP(out, outlen, setout);
-	setout(a, out, outlen);
-	memset(a, 0, 200);
+	for (; size > 0; --size)
+		absorbByte(m_state, m_blockPosition++, *data++);
+	return *this;
 }
 
+h256 Keccak256Hasher::digest() const
+{
+	array<uint64_t, 25> state = m_state;
+	// Keccak padding: 0x01 after the data and 0x80 in the last byte of the block
+	// (SHA-3 would use 0x06 instead of 0x01).
+	absorbByte(state, m_blockPosition, 0x01);
+	absorbByte(state, rate - 1, 0x80);
+	keccakf(state.data());
+
+	h256 output;
+	for (unsigned i = 0; i < h256::size; ++i)
+		output[i] = static_cast<uint8_t>(state[i / 8] >> (8 * (i % 8)));
+	return output;
 }
 
 h256 keccak256(bytesConstRef _input)
 {
-	h256 output;
-	// Parameters used:
-	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
-	// the way the round size (or window or whatever it was) is calculated.
-	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
-	return output;
+	return Keccak256Hasher{}.update(_input).digest();
 }
 
 }
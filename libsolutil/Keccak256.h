@@ -26,11 +26,37 @@
 
 #include <libsolutil/FixedHash.h>
 
+#include <array>
+#include <cstdint>
 #include <string>
 
 namespace solidity::util
 {
 
+/**
+ * Incremental computation of the Keccak-256 hash of data that is passed in pieces.
+ * Hashing the concatenation of all pieces yields the same result as the one-shot keccak256(),
+ * but the pieces never have to be copied into a single buffer.
+ */
+class Keccak256Hasher
+{
+public:
+	/// Appends @a _data to the hashed input.
+	Keccak256Hasher& update(bytesConstRef _data);
+	Keccak256Hasher& update(bytes const& _data) { return update(bytesConstRef(&_data)); }
+	Keccak256Hasher& update(std::string const& _data) { return update(bytesConstRef(_data)); }
+	/// @returns the hash of all data appended so far. More data can be appended afterwards.
+	h256 digest() const;
+
+	/// Number of input bytes absorbed by one application of the permutation.
+	static size_t constexpr rate = 200 - 2 * 32;
+
+private:
+	std::array<uint64_t, 25> m_state{};
+	/// Number of bytes of the current block that have already been absorbed into m_state.
+	size_t m_blockPosition = 0;
+};
+
 /// Calculate Keccak-256 hash of the given input, returning as a 256-bit hash.
 h256 keccak256(bytesConstRef _input);
 
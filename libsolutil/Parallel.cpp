@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+void solidity::util::parallelFor(size_t _count, unsigned _threads, function<void(size_t)> const& _task)
+{
+#ifdef __EMSCRIPTEN__
+	_threads = 1;
+#endif
+	size_t const threadCount = min<size_t>(_threads, _count);
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	vector<exception_ptr> exceptions(_count);
+	atomic<size_t> nextIndex{0};
+	auto worker = [&]()
+	{
+		for (size_t i = nextIndex++; i < _count; i = nextIndex++)
+			try
+			{
+				_task(i);
+			}
+			catch (...)
+			{
+				exceptions[i] = current_exception();
+			}
+	};
+
+	vector<thread> threads;
+	for (size_t i = 1; i < threadCount; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (auto& t: threads)
+		t.join();
+
+	for (auto const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
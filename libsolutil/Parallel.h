@@ -0,0 +1,36 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// Calls @a _task for every index in [0, @a _count) using up to @a _threads threads.
+/// The order in which the indices are processed is unspecified, so tasks must not
+/// depend on each other and should write their results into per-index slots.
+/// If @a _threads is at most 1 (or threads are not supported on the platform),
+/// the tasks are run sequentially in index order on the calling thread.
+/// If tasks throw, all remaining tasks are still run and the exception of the task with
+/// the lowest index is rethrown after all threads have finished.
+void parallelFor(std::size_t _count, unsigned _threads, std::function<void(std::size_t)> const& _task);
+
+}
@@ -0,0 +1,257 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/SHA256.h>
+
+#include <algorithm>
+#include <cstring>
+
+// The SHA extensions are only used with compilers that support enabling them for single functions,
+// so that the rest of the binary still runs on CPUs without them.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SOL_SHA256_X86_SHA_EXTENSIONS 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+alignas(16) uint32_t constexpr roundConstants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/// Processes @a _blocks blocks of 64 bytes starting at @a _data.
+using CompressFunction = void(*)(array<uint32_t, 8>& _state, uint8_t const* _data, size_t _blocks);
+
+inline uint32_t rotateRight(uint32_t _value, unsigned _bits)
+{
+	return (_value >> _bits) | (_value << (32 - _bits));
+}
+
+void compressPortable(array<uint32_t, 8>& _state, uint8_t const* _data, size_t _blocks)
+{
+	for (; _blocks > 0; --_blocks, _data += SHA256Hasher::blockSize)
+	{
+		uint32_t w[64];
+		for (size_t i = 0; i < 16; ++i)
+			w[i] =
+				(uint32_t(_data[4 * i]) << 24) |
+				(uint32_t(_data[4 * i + 1]) << 16) |
+				(uint32_t(_data[4 * i + 2]) << 8) |
+				uint32_t(_data[4 * i + 3]);
+		for (size_t i = 16; i < 64; ++i)
+		{
+			uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		uint32_t a = _state[0];
+		uint32_t b = _state[1];
+		uint32_t c = _state[2];
+		uint32_t d = _state[3];
+		uint32_t e = _state[4];
+		uint32_t f = _state[5];
+		uint32_t g = _state[6];
+		uint32_t h = _state[7];
+		for (size_t i = 0; i < 64; ++i)
+		{
+			uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+			uint32_t choice = (e & f) ^ (~e & g);
+			uint32_t t1 = h + s1 + choice + roundConstants[i] + w[i];
+			uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+			uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+			uint32_t t2 = s0 + majority;
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+		_state[0] += a;
+		_state[1] += b;
+		_state[2] += c;
+		_state[3] += d;
+		_state[4] += e;
+		_state[5] += f;
+		_state[6] += g;
+		_state[7] += h;
+	}
+}
+
+#ifdef SOL_SHA256_X86_SHA_EXTENSIONS
+
+__attribute__((target("sha,sse4.1")))
+void compressSHAExtensions(array<uint32_t, 8>& _state, uint8_t const* _data, size_t _blocks)
+{
+	__m128i const byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	// The instructions expect the state words in the order ABEF and CDGH.
+	__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&_state[0])), 0xB1);
+	__m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&_state[4])), 0x1B);
+	__m128i abef = _mm_alignr_epi8(abcd, efgh, 8);
+	__m128i cdgh = _mm_blend_epi16(efgh, abcd, 0xF0);
+
+	for (; _blocks > 0; --_blocks, _data += SHA256Hasher::blockSize)
+	{
+		__m128i const abefSaved = abef;
+		__m128i const cdghSaved = cdgh;
+		// The last four groups of four message words.
+		__m128i w[4];
+		for (size_t i = 0; i < 16; ++i)
+		{
+			if (i < 4)
+				w[i] = _mm_shuffle_epi8(
+					_mm_loadu_si128(reinterpret_cast<__m128i const*>(_data + 16 * i)),
+					byteSwapMask
+				);
+			else
+				w[i % 4] = _mm_sha256msg2_epu32(
+					_mm_add_epi32(
+						_mm_sha256msg1_epu32(w[i % 4], w[(i + 1) % 4]),
+						_mm_alignr_epi8(w[(i + 3) % 4], w[(i + 2) % 4], 4)
+					),
+					w[(i + 3) % 4]
+				);
+			__m128i message = _mm_add_epi32(
+				w[i % 4],
+				_mm_load_si128(reinterpret_cast<__m128i const*>(&roundConstants[4 * i]))
+			);
+			cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+			abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0E));
+		}
+		abef = _mm_add_epi32(abef, abefSaved);
+		cdgh = _mm_add_epi32(cdgh, cdghSaved);
+	}
+
+	__m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+	__m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&_state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&_state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+bool cpuSupportsSHAExtensions()
+{
+	unsigned eax = 0;
+	unsigned ebx = 0;
+	unsigned ecx = 0;
+	unsigned edx = 0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+	bool const ssse3 = ecx & bit_SSSE3;
+	bool const sse41 = ecx & bit_SSE4_1;
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+		return false;
+	bool const sha = ebx & bit_SHA;
+	return ssse3 && sse41 && sha;
+}
+
+#endif
+
+/// @returns the fastest compression function supported by the CPU.
+CompressFunction compressFunction()
+{
+#ifdef SOL_SHA256_X86_SHA_EXTENSIONS
+	static CompressFunction const function = cpuSupportsSHAExtensions() ? compressSHAExtensions : compressPortable;
+	return function;
+#else
+	return compressPortable;
+#endif
+}
+
+}
+
+SHA256Hasher& SHA256Hasher::update(bytesConstRef _data)
+{
+	uint8_t const* data = _data.data();
+	size_t size = _data.size();
+	m_length += size;
+	CompressFunction const compress = compressFunction();
+
+	if (m_bufferSize > 0)
+	{
+		size_t const copied = min(size, blockSize - m_bufferSize);
+		memcpy(m_buffer.data() + m_bufferSize, data, copied);
+		m_bufferSize += copied;
+		data += copied;
+		size -= copied;
+		if (m_bufferSize < blockSize)
+			return *this;
+		compress(m_state, m_buffer.data(), 1);
+		m_bufferSize = 0;
+	}
+
+	// Whole blocks are processed directly from the input.
+	if (size_t const blocks = size / blockSize)
+	{
+		compress(m_state, data, blocks);
+		data += blocks * blockSize;
+		size -= blocks * blockSize;
+	}
+
+	if (size > 0)
+	{
+		memcpy(m_buffer.data(), data, size);
+		m_bufferSize = size;
+	}
+	return *this;
+}
+
+h256 SHA256Hasher::digest() const
+{
+	array<uint32_t, 8> state = m_state;
+	// Padding: a single one bit, zeros and the length in bits as a 64 bit big-endian number.
+	array<uint8_t, 2 * blockSize> padded{};
+	memcpy(padded.data(), m_buffer.data(), m_bufferSize);
+	padded[m_bufferSize] = 0x80;
+	size_t const paddedSize = m_bufferSize + 1 + 8 <= blockSize ? blockSize : 2 * blockSize;
+	uint64_t const lengthInBits = m_length * 8;
+	for (size_t i = 0; i < 8; ++i)
+		padded[paddedSize - 1 - i] = static_cast<uint8_t>(lengthInBits >> (8 * i));
+	compressFunction()(state, padded.data(), paddedSize / blockSize);
+
+	h256 output;
+	for (unsigned i = 0; i < h256::size; ++i)
+		output[i] = static_cast<uint8_t>(state[i / 4] >> (24 - 8 * (i % 4)));
+	return output;
+}
+
+h256 solidity::util::sha256(bytesConstRef _input)
+{
+	return SHA256Hasher{}.update(_input).digest();
+}
+
+bool solidity::util::sha256UsesHardwareAcceleration()
+{
+	return compressFunction() != compressPortable;
+}
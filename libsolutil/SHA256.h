@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * SHA-256 hash function, uses the SHA extensions of the CPU if available.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace solidity::util
+{
+
+/**
+ * Incremental computation of the SHA-256 hash of data that is passed in pieces.
+ * Hashing the concatenation of all pieces yields the same result as the one-shot sha256(),
+ * but the pieces never have to be copied into a single buffer.
+ */
+class SHA256Hasher
+{
+public:
+	/// Appends @a _data to the hashed input.
+	SHA256Hasher& update(bytesConstRef _data);
+	SHA256Hasher& update(bytes const& _data) { return update(bytesConstRef(&_data)); }
+	SHA256Hasher& update(std::string const& _data) { return update(bytesConstRef(_data)); }
+	/// @returns the hash of all data appended so far. More data can be appended afterwards.
+	h256 digest() const;
+
+	static size_t constexpr blockSize = 64;
+
+private:
+	std::array<uint32_t, 8> m_state{
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	/// Input that does not fill a whole block yet.
+	std::array<uint8_t, blockSize> m_buffer{};
+	size_t m_bufferSize = 0;
+	/// Total number of input bytes.
+	uint64_t m_length = 0;
+};
+
+/// Calculate SHA-256 hash of the given input, returning as a 256-bit hash.
+h256 sha256(bytesConstRef _input);
+
+/// Calculate SHA-256 hash of the given input, returning as a 256-bit hash.
+inline h256 sha256(bytes const& _input) { return sha256(bytesConstRef(&_input)); }
+
+/// Calculate SHA-256 hash of the given input (presented as a binary-filled string), returning as a 256-bit hash.
+inline h256 sha256(std::string const& _input) { return sha256(bytesConstRef(_input)); }
+
+/// @returns true if sha256() uses the SHA extensions of the CPU instead of the portable implementation.
+bool sha256UsesHardwareAcceleration();
+
+}
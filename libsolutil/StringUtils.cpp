@@ -23,6 +23,7 @@
  */
 
 #include <libsolutil/StringUtils.h>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -86,6 +87,123 @@ size_t solidity::util::stringDistance(string const& _str1, string const& _str2)
 	return dp[(n1 % 3) + n2 * 3];
 }
 
+size_t solidity::util::unrestrictedStringDistance(string const& _str1, string const& _str2)
+{
+	size_t n1 = _str1.size();
+	size_t n2 = _str2.size();
+	size_t const infinity = n1 + n2;
+	// Algorithm by Lowrance and Wagner. The strings are 1-based and the rows have an additional
+	// first column containing infinity, so that d(i, j) is stored in row i at index j + 1.
+	// Only the previous row is kept, plus for every character the row before its last occurrence
+	// in _str1, which is all the transpositions need. This bounds the memory by the size of the
+	// alphabet instead of the length of _str1.
+	vector<size_t> previous(n2 + 2);
+	vector<size_t> current(n2 + 2);
+	previous[0] = infinity;
+	for (size_t i2 = 0; i2 <= n2; ++i2)
+		previous[i2 + 1] = i2;
+
+	// Last row of _str1 in which each character occurred so far and the row before it.
+	vector<size_t> lastRow(256, 0);
+	vector<vector<size_t>> rowBeforeLastOccurrence(256);
+	for (size_t i1 = 1; i1 <= n1; ++i1)
+	{
+		current[0] = infinity;
+		current[1] = i1;
+		// Last column of _str2 in the current row in which the characters matched.
+		size_t lastMatchingColumn = 0;
+		for (size_t i2 = 1; i2 <= n2; ++i2)
+		{
+			unsigned char character2 = static_cast<unsigned char>(_str2[i2 - 1]);
+			size_t k = lastRow[character2];
+			size_t l = lastMatchingColumn;
+			size_t cost = 1;
+			if (_str1[i1 - 1] == _str2[i2 - 1])
+			{
+				cost = 0;
+				lastMatchingColumn = i2;
+			}
+			// transposition of the characters at k and i1, with everything between them deleted or inserted
+			size_t transposition =
+				k == 0 || l == 0 ?
+				infinity :
+				rowBeforeLastOccurrence[character2][l] + (i1 - k - 1) + 1 + (i2 - l - 1);
+			current[i2 + 1] = min({
+				previous[i2] + cost,
+				current[i2] + 1,
+				previous[i2 + 1] + 1,
+				transposition
+			});
+		}
+		unsigned char character1 = static_cast<unsigned char>(_str1[i1 - 1]);
+		lastRow[character1] = i1;
+		rowBeforeLastOccurrence[character1] = previous;
+		swap(previous, current);
+	}
+
+	return previous[n2 + 1];
+}
+
+void StringDistanceIndex::insert(string const& _string)
+{
+	if (m_lenThreshold > 0 && _string.size() * _string.size() > m_lenThreshold)
+	{
+		m_longStrings.insert(_string);
+		return;
+	}
+
+	m_maxLength = max(m_maxLength, _string.size());
+	if (m_nodes.empty())
+	{
+		m_nodes.push_back({_string, {}});
+		return;
+	}
+
+	size_t node = 0;
+	while (true)
+	{
+		size_t distance = unrestrictedStringDistance(_string, m_nodes[node].value);
+		if (distance == 0)
+			return;
+		auto [it, inserted] = m_nodes[node].children.emplace(distance, m_nodes.size());
+		if (inserted)
+		{
+			m_nodes.push_back({_string, {}});
+			return;
+		}
+		node = it->second;
+	}
+}
+
+vector<string const*> StringDistanceIndex::within(string const& _string, size_t _maxDistance) const
+{
+	vector<string const*> result;
+	for (string const& longString: m_longStrings)
+		if (stringWithinDistance(_string, longString, _maxDistance, m_lenThreshold))
+			result.push_back(&longString);
+
+	// The distance is at least the difference of the lengths, so no string in the tree can be close enough.
+	if (m_nodes.empty() || _string.size() > m_maxLength + _maxDistance)
+		return result;
+
+	vector<size_t> pending{0};
+	while (!pending.empty())
+	{
+		Node const& node = m_nodes[pending.back()];
+		pending.pop_back();
+		size_t distance = unrestrictedStringDistance(_string, node.value);
+		if (distance <= _maxDistance)
+			result.push_back(&node.value);
+		for (
+			auto it = node.children.lower_bound(distance > _maxDistance ? distance - _maxDistance : 0);
+			it != node.children.end() && it->first <= distance + _maxDistance;
+			++it
+		)
+			pending.push_back(it->second);
+	}
+	return result;
+}
+
 string solidity::util::quotedAlternativesList(vector<string> const& suggestions)
 {
 	vector<string> quotedSuggestions;
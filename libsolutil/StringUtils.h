@@ -30,6 +30,8 @@
 #include <algorithm>
 #include <limits>
 #include <locale>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -41,9 +43,49 @@ namespace solidity::util
 bool stringWithinDistance(std::string const& _str1, std::string const& _str2, size_t _maxDistance, size_t _lenThreshold = 0);
 // Calculates the Damerau–Levenshtein distance between _str1 and _str2
 size_t stringDistance(std::string const& _str1, std::string const& _str2);
+// Calculates the Damerau–Levenshtein distance between _str1 and _str2 without the restriction of stringDistance
+// that transposed characters cannot be edited further. Unlike stringDistance, this is a metric and never larger.
+size_t unrestrictedStringDistance(std::string const& _str1, std::string const& _str2);
 // Return a string having elements of suggestions as quoted, alternative suggestions. e.g. "a", "b" or "c"
 std::string quotedAlternativesList(std::vector<std::string> const& suggestions);
 
+/**
+ * Set of strings organized as a BK-tree, which finds the strings close to a given string without comparing
+ * it to all of them. Every child of a node is labelled with its distance to the node. By the triangle
+ * inequality, only the children whose label differs from the distance between the query and the node
+ * by at most the maximum distance can lead to results.
+ * Since unrestrictedStringDistance is used as the metric, the result is a superset of the strings within
+ * the same stringDistance.
+ * Strings whose squared length exceeds the length threshold (if non-zero) are kept out of the tree and
+ * compared to the query using stringWithinDistance with the same threshold, as a linear search would.
+ */
+class StringDistanceIndex
+{
+public:
+	explicit StringDistanceIndex(size_t _lenThreshold = 0): m_lenThreshold(_lenThreshold) {}
+
+	/// Adds @a _string to the set, unless it is already contained.
+	void insert(std::string const& _string);
+	/// @returns all strings in the tree whose unrestrictedStringDistance to @a _string is at most @a _maxDistance
+	/// and all strings above the length threshold for which stringWithinDistance returns true.
+	std::vector<std::string const*> within(std::string const& _string, size_t _maxDistance) const;
+	size_t size() const { return m_nodes.size() + m_longStrings.size(); }
+
+private:
+	struct Node
+	{
+		std::string value;
+		/// Indices of the children, by their distance to this node.
+		std::map<size_t, size_t> children;
+	};
+	size_t m_lenThreshold = 0;
+	std::vector<Node> m_nodes;
+	/// Length of the longest string in the tree.
+	size_t m_maxLength = 0;
+	/// Strings above the length threshold, which are not part of the tree.
+	std::set<std::string> m_longStrings;
+};
+
 /// @returns a string containing a comma-separated list of variable names consisting of @a _baseName suffixed
 /// with increasing integers in the range [@a _startSuffix, @a _endSuffix), if @a _startSuffix < @a _endSuffix,
 /// and with decreasing integers in the range [@a _endSuffix, @a _startSuffix), if @a _endSuffix < @a _startSuffix.
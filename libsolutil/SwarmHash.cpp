@@ -39,7 +39,7 @@ bytes toLittleEndian(uint64_t _size)
 
 h256 swarmHashSimple(bytesConstRef _data, size_t _size)
 {
-	return keccak256(toLittleEndian(_size) + _data.toBytes());
+	return Keccak256Hasher{}.update(toLittleEndian(_size)).update(_data).digest();
 }
 
 h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
@@ -69,10 +69,10 @@ h256 bmtHash(bytesConstRef _data)
 		return keccak256(_data);
 
 	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	return Keccak256Hasher{}
+		.update(bmtHash(_data.cropped(0, midPoint)).ref())
+		.update(bmtHash(_data.cropped(midPoint)).ref())
+		.digest();
 }
 
 h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
@@ -98,7 +98,7 @@ h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
 	}
 
 	dataToHash.resize(0x1000, 0);
-	return keccak256(toLittleEndian(_data.size()) + bmtHash(&dataToHash).asBytes());
+	return Keccak256Hasher{}.update(toLittleEndian(_data.size())).update(bmtHash(&dataToHash).ref()).digest();
 }
 
 
@@ -26,11 +26,34 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the length of the parameter name that starts at @a _pos in @a _template, zero if there is none.
+size_t parameterLength(string const& _template, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _template.size() && isParameterCharacter(_template[end]))
+		++end;
+	return end - _pos;
+}
+
+}
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -76,9 +99,8 @@ string Whiskers::render() const
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -116,32 +138,6 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
-{
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
-
 string Whiskers::replace(
 	string const& _template,
 	StringMap const& _parameters,
@@ -149,46 +145,63 @@ string Whiskers::replace(
 	map<string, vector<StringMap>> const& _listParameters
 )
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
+	string result;
+	result.reserve(_template.size());
+	// Everything before this position has been copied or replaced already.
+	size_t copiedUntil = 0;
+	for (size_t tagStart = _template.find('<'); tagStart != string::npos; tagStart = _template.find('<', tagStart + 1))
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
+		size_t nameStart = tagStart + 1;
+		char kind = nameStart < _template.size() ? _template[nameStart] : '\0';
+		if (kind == '#' || kind == '?')
+			++nameStart;
+		size_t nameEnd = nameStart;
+		if (kind == '?' && nameEnd < _template.size() && _template[nameEnd] == '+')
+			++nameEnd;
+		size_t const length = parameterLength(_template, nameEnd);
+		nameEnd += length;
+		if (length == 0 || nameEnd >= _template.size() || _template[nameEnd] != '>')
+			continue;
+
+		string const name = _template.substr(nameStart, nameEnd - nameStart);
+		size_t const bodyStart = nameEnd + 1;
+		size_t tagEnd = bodyStart;
+		string replacement;
+		if (kind == '#')
 		{
-			string templ(_match[3]);
+			string const closingTag = "</" + name + ">";
+			size_t const bodyEnd = _template.find(closingTag, bodyStart);
+			if (bodyEnd == string::npos)
+				continue;
+			tagEnd = bodyEnd + closingTag.size();
+
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_listParameters.count(name),
+				WhiskersError, "List parameter " + name + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			string const body = _template.substr(bodyStart, bodyEnd - bodyStart);
+			for (auto const& parameters: _listParameters.at(name))
+				replacement += replace(body, joinMaps(_parameters, parameters), _conditions);
 		}
-		else
+		else if (kind == '?')
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
+			string const closingTag = "</" + name + ">";
+			string const elseTag = "<!" + name + ">";
+			size_t const bodyEnd = _template.find(closingTag, bodyStart);
+			if (bodyEnd == string::npos)
+				continue;
+			tagEnd = bodyEnd + closingTag.size();
+			size_t thenEnd = _template.find(elseTag, bodyStart);
+			size_t elseStart = bodyEnd;
+			if (thenEnd < bodyEnd)
+				elseStart = thenEnd + elseTag.size();
+			else
+				thenEnd = bodyEnd;
+
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (name[0] == '+')
 			{
-				string tag = conditionName.substr(1);
+				string tag = name.substr(1);
 
 				if (_parameters.count(tag))
 					conditionValue = !_parameters.at(tag).empty();
@@ -200,19 +213,39 @@ string Whiskers::replace(
 			else
 			{
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					_conditions.count(name),
+					WhiskersError, "Condition parameter " + name + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = _conditions.at(name);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
+			replacement = replace(
+				conditionValue ?
+					_template.substr(bodyStart, thenEnd - bodyStart) :
+					_template.substr(elseStart, bodyEnd - elseStart),
 				_parameters,
 				_conditions,
 				_listParameters
 			);
 		}
-	});
+		else
+		{
+			assertThrow(
+				_parameters.count(name),
+				WhiskersError,
+				"Value for tag " + name + " not provided.\n" +
+				"Template:\n" +
+				_template
+			);
+			replacement = _parameters.at(name);
+		}
+
+		result.append(_template, copiedUntil, tagStart - copiedUntil);
+		result += replacement;
+		copiedUntil = tagEnd;
+		tagStart = tagEnd - 1;
+	}
+	result.append(_template, copiedUntil, string::npos);
+	return result;
 }
 
 Whiskers::StringMap Whiskers::joinMaps(
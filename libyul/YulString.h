@@ -25,6 +25,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -35,7 +36,8 @@ namespace solidity::yul
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
+/// non-deterministic), a deterministic string hash and a pointer to the string data.
+/// Strings can be registered concurrently from multiple threads.
 class YulStringRepository
 {
 public:
@@ -43,6 +45,8 @@ public:
 	{
 		size_t id;
 		std::uint64_t hash;
+		/// Points to the string owned by the repository, nullptr for the empty string.
+		std::string const* string;
 	};
 
 	static YulStringRepository& instance()
@@ -54,19 +58,32 @@ public:
 	Handle stringToHandle(std::string const& _string)
 	{
 		if (_string.empty())
-			return { 0, emptyHash() };
+			return { 0, emptyHash(), nullptr };
 		std::uint64_t h = hash(_string);
+		std::lock_guard<std::mutex> lock(m_mutex);
 		auto range = m_hashToID.equal_range(h);
 		for (auto it = range.first; it != range.second; ++it)
 			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
+				return Handle{it->second, h, m_strings[it->second].get()};
 		m_strings.emplace_back(std::make_shared<std::string>(_string));
+		m_totalLength += _string.size();
 		size_t id = m_strings.size() - 1;
 		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
 
-		return Handle{id, h};
+		return Handle{id, h, m_strings.back().get()};
+	}
+	std::string const& idToString(size_t _id) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return *m_strings.at(_id);
+	}
+	/// @returns the combined length of all strings in the repository.
+	/// Long-running processes can use it to decide when to reset the repository.
+	std::size_t totalLength() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_totalLength;
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -89,7 +106,11 @@ public:
 	{
 		for (auto const& cb: resetCallbacks())
 			cb();
-		instance() = YulStringRepository{};
+		YulStringRepository& repository = instance();
+		std::lock_guard<std::mutex> lock(repository.m_mutex);
+		repository.m_strings = {std::make_shared<std::string>()};
+		repository.m_hashToID = {{emptyHash(), 0}};
+		repository.m_totalLength = 0;
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
@@ -104,9 +125,7 @@ public:
 private:
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -116,6 +135,8 @@ private:
 
 	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
 	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::size_t m_totalLength = 0;
+	mutable std::mutex m_mutex;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -152,14 +173,15 @@ public:
 	bool empty() const { return m_handle.id == 0; }
 	std::string const& str() const
 	{
-		return YulStringRepository::instance().idToString(m_handle.id);
+		static std::string const emptyString;
+		return m_handle.string ? *m_handle.string : emptyString;
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
 	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash(), nullptr };
 };
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
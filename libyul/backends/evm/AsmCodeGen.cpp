@@ -39,10 +39,11 @@ void CodeGenerator::assemble(
 	langutil::EVMVersion _evmVersion,
 	ExternalIdentifierAccess::CodeGenerator _identifierAccessCodeGen,
 	bool _useNamedLabelsForFunctions,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	optional<SourceLocation> _sourceLocationOverride
 )
 {
-	EthAssemblyAdapter assemblyAdapter(_assembly);
+	EthAssemblyAdapter assemblyAdapter(_assembly, std::move(_sourceLocationOverride));
 	BuiltinContext builtinContext;
 	CodeTransform transform(
 		assemblyAdapter,
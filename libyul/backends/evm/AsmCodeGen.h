@@ -24,6 +24,9 @@
 #include <libyul/backends/evm/AbstractAssembly.h>
 #include <libyul/AsmAnalysis.h>
 #include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceLocation.h>
+
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -39,6 +42,8 @@ class CodeGenerator
 {
 public:
 	/// Performs code generation and appends generated to _assembly.
+	/// If @a _sourceLocationOverride is set, it is used as the source location of all
+	/// generated items instead of the locations stored in the debug data of @a _parsedData.
 	static void assemble(
 		Block const& _parsedData,
 		AsmAnalysisInfo& _analysisInfo,
@@ -46,7 +51,8 @@ public:
 		langutil::EVMVersion _evmVersion,
 		ExternalIdentifierAccess::CodeGenerator _identifierAccess = {},
 		bool _useNamedLabelsForFunctions = false,
-		bool _optimizeStackAllocation = false
+		bool _optimizeStackAllocation = false,
+		std::optional<langutil::SourceLocation> _sourceLocationOverride = std::nullopt
 	);
 };
 }
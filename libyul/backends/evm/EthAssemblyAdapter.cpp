@@ -39,14 +39,18 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
-EthAssemblyAdapter::EthAssemblyAdapter(evmasm::Assembly& _assembly):
-	m_assembly(_assembly)
+EthAssemblyAdapter::EthAssemblyAdapter(
+	evmasm::Assembly& _assembly,
+	optional<SourceLocation> _sourceLocationOverride
+):
+	m_assembly(_assembly),
+	m_sourceLocationOverride(std::move(_sourceLocationOverride))
 {
 }
 
 void EthAssemblyAdapter::setSourceLocation(SourceLocation const& _location)
 {
-	m_assembly.setSourceLocation(_location);
+	m_assembly.setSourceLocation(m_sourceLocationOverride ? *m_sourceLocationOverride : _location);
 }
 
 int EthAssemblyAdapter::stackHeight() const
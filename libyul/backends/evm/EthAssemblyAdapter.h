@@ -27,6 +27,7 @@
 
 #include <functional>
 #include <limits>
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -39,7 +40,12 @@ namespace solidity::yul
 class EthAssemblyAdapter: public AbstractAssembly
 {
 public:
-	explicit EthAssemblyAdapter(evmasm::Assembly& _assembly);
+	/// @param _sourceLocationOverride if set, all appended items get this source location
+	/// instead of the one of the Yul node that produced them.
+	explicit EthAssemblyAdapter(
+		evmasm::Assembly& _assembly,
+		std::optional<langutil::SourceLocation> _sourceLocationOverride = std::nullopt
+	);
 	void setSourceLocation(langutil::SourceLocation const& _location) override;
 	int stackHeight() const override;
 	void setStackHeight(int height) override;
@@ -72,6 +78,7 @@ private:
 	void appendJumpInstruction(evmasm::Instruction _instruction, JumpType _jumpType);
 
 	evmasm::Assembly& m_assembly;
+	std::optional<langutil::SourceLocation> m_sourceLocationOverride;
 	std::map<SubID, u256> m_dataHashBySubId;
 	size_t m_nextDataCounter = std::numeric_limits<size_t>::max() / 2;
 };
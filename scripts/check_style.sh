@@ -5,7 +5,6 @@ set -eu
 ERROR_LOG="$(mktemp -t check_style_XXXXXX.log)"
 
 EXCLUDE_FILES=(
-    "libsolutil/picosha2.h"
     "test/cmdlineTests/strict_asm_only_cr/input.yul"
     "test/cmdlineTests/strict_asm_only_cr/err"
     "test/libsolutil/UTF8.cpp"
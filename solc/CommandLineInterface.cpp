@@ -31,6 +31,7 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
+#include <libsolidity/ast/ASTSnapshot.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
@@ -42,6 +43,7 @@
 #include <libsolidity/lsp/Transport.h>
 
 #include <libyul/YulStack.h>
+#include <libyul/YulString.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Disassemble.h>
@@ -520,6 +522,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::Server &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -535,6 +538,19 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 
 	for (SourceCode const& sourceCode: m_fileReader.sourceUnits() | ranges::views::values)
 	{
+		if (ASTSnapshot::isSnapshot(sourceCode))
+		{
+			for (auto&& [src, sourceJson]: ASTSnapshot::decode(sourceCode))
+			{
+				astAssert(sourceJson["nodeType"].asString() == "SourceUnit", "Top-level node should be a 'SourceUnit'");
+				astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
+				// There is no source text to keep. The compiler creates the text of imported sources itself.
+				tmpSources[src] = "";
+				sourceJsons.emplace(src, move(sourceJson));
+			}
+			continue;
+		}
+
 		Json::Value ast;
 		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
@@ -643,13 +659,17 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value(), "");
 
 		StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
-		sout() << compiler.compile(move(m_standardJsonInput.value())) << endl;
+		compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << endl;
 		m_standardJsonInput.reset();
 		break;
 	}
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
+	case InputMode::Server:
+		serveStandardJson();
+		break;
 	case InputMode::Assembler:
 		assemble(m_options.assembly.inputLanguage, m_options.assembly.targetMachine);
 		break;
@@ -749,6 +769,7 @@ void CommandLineInterface::compile()
 		{
 			m_compiler->setSources(m_fileReader.sourceUnits());
 			m_compiler->setParserErrorRecovery(m_options.input.errorRecovery);
+			m_compiler->setThreads(m_options.input.threads);
 		}
 
 		bool successful = m_compiler->compile(m_options.output.stopAfter);
@@ -880,6 +901,15 @@ void CommandLineInterface::handleAst()
 {
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
 
+	if (m_options.compiler.outputs.astSnapshot)
+	{
+		solAssert(!m_options.output.dir.empty(), "");
+		map<string, Json::Value> sourceASTs;
+		for (auto const& sourceCode: m_fileReader.sourceUnits())
+			sourceASTs[sourceCode.first] = ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).toJson(m_compiler->ast(sourceCode.first));
+		createFile("combined.astsnapshot", ASTSnapshot::encode(sourceASTs));
+	}
+
 	if (!m_options.compiler.outputs.astCompactJson)
 		return;
 
@@ -917,6 +947,32 @@ void CommandLineInterface::serveLSP()
 		solThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	solAssert(m_options.input.mode == InputMode::Server, "");
+
+	size_t const cacheLimit = m_options.input.serverCacheLimit;
+	m_fileReader.setFileCacheLimit(cacheLimit);
+
+	StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
+	compiler.setClearYulStrings(false);
+
+	string line;
+	while (getline(m_sin, line))
+	{
+		if (line.find_first_not_of(" \t\r") == string::npos)
+			continue;
+
+		compiler.compile(line, sout());
+		sout() << endl;
+
+		// Only the file contents are kept, the sources belong to the finished input.
+		m_fileReader.setSourceUnits({});
+		if (yul::YulStringRepository::instance().totalLength() > cacheLimit)
+			yul::YulStringRepository::reset();
+	}
+}
+
 void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker, "");
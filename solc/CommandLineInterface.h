@@ -83,6 +83,9 @@ private:
 	void printLicense();
 	void compile();
 	void serveLSP();
+	/// Compiles the Standard JSON inputs read from standard input line by line and writes
+	/// every output as a single line, keeping caches between the inputs.
+	void serveStandardJson();
 	void link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
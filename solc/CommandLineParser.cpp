@@ -30,6 +30,8 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/range/conversion.hpp>
 
+#include <limits>
+
 using namespace std;
 using namespace solidity::langutil;
 
@@ -64,6 +66,7 @@ static string const g_strLSP = "lsp";
 static string const g_strMachine = "machine";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
@@ -71,6 +74,7 @@ static string const g_strModelCheckerInvariants = "model-checker-invariants";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
+static string const g_strModelCheckerThreads = "model-checker-threads";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
@@ -93,11 +97,14 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strServer = "server";
+static string const g_strServerCacheLimit = "server-cache-limit";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
+static string const g_strThreads = "threads";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strJsonIndent = "json-indent";
 static string const g_strVersion = "version";
@@ -138,6 +145,7 @@ static map<InputMode, string> const g_inputModeName = {
 	{InputMode::StandardJson, "standard JSON"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
+	{InputMode::Server, "server"},
 };
 
 void CommandLineParser::checkMutuallyExclusive(vector<string> const& _optionNames)
@@ -223,6 +231,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
 		input.errorRecovery == _other.input.errorRecovery &&
+		input.threads == _other.input.threads &&
+		input.serverCacheLimit == _other.input.serverCacheLimit &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
@@ -317,7 +327,17 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::Server)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin || !m_options.input.remappings.empty())
+			solThrow(
+				CommandLineValidationError,
+				"Input files and import remappings are not accepted in server mode.\n"
+				"The Standard JSON inputs are read from standard input. Please put remappings "
+				"under 'settings.remappings' in the JSON input."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -466,6 +486,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::Server:
 		case InputMode::Linker:
 			return false;
 		}
@@ -557,6 +578,13 @@ General Information)").c_str(),
 			g_strErrorRecovery.c_str(),
 			"Enables additional parser error recovery."
 		)
+		(
+			g_strThreads.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Set the maximum number of threads used to parse the input sources and to run "
+			"the analysis steps that only concern a single source concurrently. "
+			"The default is 1, that is, all sources are processed sequentially."
+		)
 	;
 	desc.add(inputOptions);
 
@@ -612,6 +640,13 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			"Switch to batch compilation server mode, ignoring all options except those for reading files. "
+			"Reads Standard JSON inputs from standard input, one per line, until the end of the input. "
+			"The output for every input is written to standard output as a single line, in the order of the inputs. "
+			"Files read from disk and Yul strings are cached between the inputs."
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -676,6 +711,19 @@ General Information)").c_str(),
 	;
 	desc.add(linkerModeOptions);
 
+	po::options_description serverModeOptions("Server Mode Options");
+	serverModeOptions.add_options()
+		(
+			g_strServerCacheLimit.c_str(),
+			po::value<size_t>()->value_name("MiB"),
+			("Maximum size of each of the caches kept between inputs in server mode. "
+			"The cached file contents are evicted in least recently used order and the Yul strings are "
+			"dropped once they exceed the limit. "
+			"The default is " + to_string(CommandLineOptions{}.input.serverCacheLimit / (1024 * 1024)) + ".").c_str()
+		)
+	;
+	desc.add(serverModeOptions);
+
 	po::options_description outputFormatting("Output Formatting");
 	outputFormatting.add_options()
 		(
@@ -705,6 +753,11 @@ General Information)").c_str(),
 	po::options_description outputComponents("Output Components");
 	outputComponents.add_options()
 		(CompilerOutputs::componentName(&CompilerOutputs::astCompactJson).c_str(), "AST of all source files in a compact JSON format.")
+		(
+			CompilerOutputs::componentName(&CompilerOutputs::astSnapshot).c_str(),
+			"AST of all source files in a binary format that can be imported with --import-ast much faster than JSON. "
+			"Requires --output-dir."
+		)
 		(CompilerOutputs::componentName(&CompilerOutputs::asm_).c_str(), "EVM assembly of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::asmJson).c_str(), "EVM assembly of the contracts in JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::opcodes).c_str(), "Opcodes of the contracts.")
@@ -783,6 +836,12 @@ General Information)").c_str(),
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the results of solved queries in the given directory and reuse them "
+			"instead of invoking the solvers again when the same queries are seen in later runs."
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -823,6 +882,13 @@ General Information)").c_str(),
 			"Multiple targets can be selected at the same time, separated by a comma and no spaces."
 			" By default all targets except underflow and overflow are selected."
 		)
+		(
+			g_strModelCheckerThreads.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Set the maximum number of threads the model checker uses to solve "
+			"independent queries concurrently with the Z3 solver. "
+			"The default is 1, that is, all queries are solved sequentially."
+		)
 		(
 			g_strModelCheckerTimeout.c_str(),
 			po::value<unsigned>()->value_name("ms"),
@@ -878,7 +944,8 @@ void CommandLineParser::processArgs()
 		g_strStrictAssembly,
 		g_strYul,
 		g_strImportAst,
-		g_strLSP
+		g_strLSP,
+		g_strServer
 	});
 
 	if (m_args.count(g_strHelp) > 0)
@@ -891,6 +958,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::StandardJson;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
+	else if (m_args.count(g_strServer))
+		m_options.input.mode = InputMode::Server;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0 || m_args.count(g_strYul) > 0)
 		m_options.input.mode = InputMode::Assembler;
 	else if (m_args.count(g_strLink) > 0)
@@ -911,6 +980,8 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strServerCacheLimit, {InputMode::Server}},
+		{g_strThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
 	};
 	vector<string> invalidOptionsForCurrentInputMode;
@@ -1024,9 +1095,21 @@ void CommandLineParser::processArgs()
 		m_options.formatting.json.format = util::JsonFormat::Pretty;
 		m_options.formatting.json.indent = m_args[g_strJsonIndent].as<uint32_t>();
 	}
+	if (m_options.input.mode == InputMode::Server && m_options.formatting.json.format == util::JsonFormat::Pretty)
+		solThrow(
+			CommandLineValidationError,
+			"Options --" + g_strPrettyJson + " and --" + g_strJsonIndent + " are not supported in server mode, "
+			"which writes every output on a single line."
+		);
 
 	parseOutputSelection();
 
+	if (m_options.compiler.outputs.astSnapshot && m_options.output.dir.empty())
+		solThrow(
+			CommandLineValidationError,
+			"Option --" + CompilerOutputs::componentName(&CompilerOutputs::astSnapshot) + " requires --" + g_strOutputDir + "."
+		);
+
 	m_options.compiler.estimateGas = (m_args.count(g_strGas) > 0);
 
 	if (m_args.count(g_strBasePath))
@@ -1064,6 +1147,18 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
+	if (m_options.input.mode == InputMode::Server)
+	{
+		if (m_args.count(g_strServerCacheLimit))
+		{
+			size_t cacheLimit = m_args[g_strServerCacheLimit].as<size_t>();
+			if (cacheLimit > numeric_limits<size_t>::max() / (1024 * 1024))
+				solThrow(CommandLineValidationError, "--" + g_strServerCacheLimit + " is too large.");
+			m_options.input.serverCacheLimit = cacheLimit * 1024 * 1024;
+		}
+		return;
+	}
+
 	if (m_options.input.mode == InputMode::StandardJson)
 		return;
 
@@ -1198,6 +1293,9 @@ void CommandLineParser::processArgs()
 			solThrow(CommandLineValidationError, "Invalid option for --" + g_strMetadataHash + ": " + hashStr);
 	}
 
+	if (m_args.count(g_strModelCheckerCacheDir))
+		m_options.modelChecker.settings.cacheDirectory = m_args[g_strModelCheckerCacheDir].as<string>();
+
 	if (m_args.count(g_strModelCheckerContracts))
 	{
 		string contractsStr = m_args[g_strModelCheckerContracts].as<string>();
@@ -1249,11 +1347,20 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.targets = *targets;
 	}
 
+	if (m_args.count(g_strModelCheckerThreads))
+	{
+		unsigned threads = m_args[g_strModelCheckerThreads].as<unsigned>();
+		if (threads == 0)
+			solThrow(CommandLineValidationError, "--" + g_strModelCheckerThreads + " must be at least 1.");
+		m_options.modelChecker.settings.threads = threads;
+	}
+
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerCacheDir) ||
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
@@ -1261,11 +1368,19 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
+		m_args.count(g_strModelCheckerThreads) ||
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 	if (m_options.input.mode == InputMode::Compiler)
 		m_options.input.errorRecovery = (m_args.count(g_strErrorRecovery) > 0);
 
+	if (m_options.input.mode == InputMode::Compiler && m_args.count(g_strThreads))
+	{
+		m_options.input.threads = m_args[g_strThreads].as<unsigned>();
+		if (m_options.input.threads == 0)
+			solThrow(CommandLineValidationError, "--" + g_strThreads + " must be at least 1.");
+	}
+
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport);
 }
 
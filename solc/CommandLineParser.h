@@ -56,7 +56,8 @@ enum class InputMode
 	StandardJson,
 	Linker,
 	Assembler,
-	LanguageServer
+	LanguageServer,
+	Server
 };
 
 struct CompilerOutputs
@@ -70,6 +71,7 @@ struct CompilerOutputs
 	{
 		static std::map<std::string, bool CompilerOutputs::*> const components = {
 			{"ast-compact-json", &CompilerOutputs::astCompactJson},
+			{"ast-snapshot", &CompilerOutputs::astSnapshot},
 			{"asm", &CompilerOutputs::asm_},
 			{"asm-json", &CompilerOutputs::asmJson},
 			{"opcodes", &CompilerOutputs::opcodes},
@@ -90,6 +92,7 @@ struct CompilerOutputs
 	}
 
 	bool astCompactJson = false;
+	bool astSnapshot = false;
 	bool asm_ = false;
 	bool asmJson = false;
 	bool opcodes = false;
@@ -175,6 +178,9 @@ struct CommandLineOptions
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
 		bool errorRecovery = false;
+		unsigned threads = 1;
+		/// Maximum size in bytes of each cache kept between the inputs in server mode.
+		std::size_t serverCacheLimit = 256 * 1024 * 1024;
 	} input;
 
 	struct
@@ -29,7 +29,7 @@
 #include <libsolutil/Exceptions.h>
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Keccak256.h>
-#include <libsolutil/picosha2.h>
+#include <libsolutil/SHA256.h>
 
 using namespace std;
 using namespace solidity;
@@ -147,6 +147,8 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 void EVMHost::reset()
 {
 	accounts.clear();
+	m_accountsSnapshot.reset();
+	m_modifiedAccounts.clear();
 	m_currentAddress = {};
 	// Clear self destruct records
 	recorded_selfdestructs.clear();
@@ -179,7 +181,81 @@ void EVMHost::resetWarmAccess()
 	// Clear EIP-2929 storage access indicator
 	for (auto& [address, account]: accounts)
 		for (auto& [slot, value]: account.storage)
-			value.access_status = EVMC_ACCESS_COLD;
+			if (value.access_status != EVMC_ACCESS_COLD)
+			{
+				journalAccount(address);
+				value.access_status = EVMC_ACCESS_COLD;
+			}
+}
+
+EVMHost::Snapshot EVMHost::snapshot()
+{
+	assertThrow(m_journal.empty(), Exception, "Snapshot requested during a call.");
+	if (!m_accountsSnapshot || !m_modifiedAccounts.empty())
+	{
+		m_accountsSnapshot = make_shared<Accounts const>(accounts);
+		m_modifiedAccounts.clear();
+	}
+	return {m_accountsSnapshot, tx_context, recorded_account_accesses, recorded_calls, recorded_logs, recorded_selfdestructs};
+}
+
+void EVMHost::restore(Snapshot const& _snapshot)
+{
+	assertThrow(m_journal.empty(), Exception, "Snapshot restored during a call.");
+	assertThrow(_snapshot.accounts, Exception, "Invalid snapshot.");
+	if (_snapshot.accounts == m_accountsSnapshot)
+		for (evmc::address const& address: m_modifiedAccounts)
+		{
+			auto it = _snapshot.accounts->find(address);
+			if (it == _snapshot.accounts->end())
+				accounts.erase(address);
+			else
+				accounts[address] = it->second;
+		}
+	else
+	{
+		accounts = *_snapshot.accounts;
+		m_accountsSnapshot = _snapshot.accounts;
+	}
+	m_modifiedAccounts.clear();
+
+	tx_context = _snapshot.txContext;
+	recorded_account_accesses = _snapshot.accountAccesses;
+	recorded_calls = _snapshot.calls;
+	recorded_logs = _snapshot.logs;
+	recorded_selfdestructs = _snapshot.selfdestructs;
+}
+
+void EVMHost::journalAccount(evmc::address const& _address)
+{
+	m_modifiedAccounts.insert(_address);
+	if (m_journal.empty() || m_journal.back().count(_address))
+		return;
+	auto it = accounts.find(_address);
+	m_journal.back().emplace(
+		_address,
+		it == accounts.end() ? nullopt : optional<evmc::MockedAccount>(it->second)
+	);
+}
+
+void EVMHost::revertCallFrame()
+{
+	for (auto& [address, account]: m_journal.back())
+		if (account)
+			accounts[address] = move(*account);
+		else
+			accounts.erase(address);
+	m_journal.pop_back();
+}
+
+void EVMHost::commitCallFrame()
+{
+	AccountJournal journal = move(m_journal.back());
+	m_journal.pop_back();
+	// The parent frame has to be able to undo the modifications as well.
+	if (!m_journal.empty())
+		for (auto& [address, account]: journal)
+			m_journal.back().try_emplace(address, move(account));
 }
 
 void EVMHost::transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept
@@ -189,10 +265,28 @@ void EVMHost::transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recip
 	_recipient.balance = convertToEVMC(u256(convertFromEVMC(_recipient.balance)) + _value);
 }
 
+evmc_storage_status EVMHost::set_storage(
+	evmc::address const& _addr,
+	evmc::bytes32 const& _key,
+	evmc::bytes32 const& _value
+) noexcept
+{
+	journalAccount(_addr);
+	return MockedHost::set_storage(_addr, _key, _value);
+}
+
+evmc_access_status EVMHost::access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept
+{
+	journalAccount(_addr);
+	return MockedHost::access_storage(_addr, _key);
+}
+
 void EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _beneficiary) noexcept
 {
 	// TODO actual selfdestruct is even more complicated.
 
+	journalAccount(_addr);
+	journalAccount(_beneficiary);
 	transfer(accounts[_addr], accounts[_beneficiary], convertFromEVMC(accounts[_addr].balance));
 	accounts.erase(_addr);
 	// Record self destructs
@@ -225,9 +319,11 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	else if (_message.destination == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
 		return precompileALTBN128PairingProduct(_message);
 
-	auto const stateBackup = accounts;
+	// Modified accounts are journaled instead of copying the whole state, so that failing calls can be reverted.
+	m_journal.emplace_back();
 
 	u256 value{convertFromEVMC(_message.value)};
+	journalAccount(_message.sender);
 	auto& sender = accounts[_message.sender];
 
 	evmc::bytes code;
@@ -242,7 +338,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertCallFrame();
 			return result;
 		}
 	}
@@ -274,7 +370,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertCallFrame();
 			return result;
 		}
 
@@ -282,12 +378,17 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	else if (message.kind == EVMC_DELEGATECALL || message.kind == EVMC_CALLCODE)
 	{
+		journalAccount(message.destination);
 		code = accounts[message.destination].code;
 		message.destination = m_currentAddress;
 	}
 	else
+	{
+		journalAccount(message.destination);
 		code = accounts[message.destination].code;
+	}
 
+	journalAccount(message.destination);
 	auto& destination = accounts[message.destination];
 
 	if (value != 0 && message.kind != EVMC_DELEGATECALL && message.kind != EVMC_CALLCODE)
@@ -296,7 +397,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_INSUFFICIENT_BALANCE;
-			accounts = stateBackup;
+			revertCallFrame();
 			return result;
 		}
 		transfer(sender, destination, value);
@@ -333,7 +434,9 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 
 	if (result.status_code != EVMC_SUCCESS)
-		accounts = stateBackup;
+		revertCallFrame();
+	else
+		commitCallFrame();
 
 	return result;
 }
@@ -402,10 +505,7 @@ evmc::result EVMHost::precompileSha256(evmc_message const& _message) noexcept
 {
 	// static data so that we do not need a release routine...
 	bytes static hash;
-	hash = picosha2::hash256(bytes(
-		_message.input_data,
-		_message.input_data + _message.input_size
-	));
+	hash = sha256(bytesConstRef(_message.input_data, _message.input_size)).asBytes();
 
 	evmc::result result({});
 	result.gas_left = _message.gas;
@@ -32,6 +32,12 @@
 
 #include <boost/filesystem.hpp>
 
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace solidity::test
 {
 using Address = util::h160;
@@ -39,6 +45,20 @@ using Address = util::h160;
 class EVMHost: public evmc::MockedHost
 {
 public:
+	using Accounts = std::unordered_map<evmc::address, evmc::MockedAccount>;
+
+	/// State of the host recorded by snapshot(). Copies of a snapshot share the recorded accounts,
+	/// which are never modified.
+	struct Snapshot
+	{
+		std::shared_ptr<Accounts const> accounts;
+		evmc_tx_context txContext = {};
+		std::vector<evmc::address> accountAccesses;
+		std::vector<evmc_message> calls;
+		std::vector<log_record> logs;
+		std::vector<selfdestruct_record> selfdestructs;
+	};
+
 	using MockedHost::get_code_size;
 	using MockedHost::get_balance;
 
@@ -58,6 +78,15 @@ public:
 	void reset();
 	/// Clears EIP-2929 account and storage access indicator
 	void resetWarmAccess();
+
+	/// @returns a snapshot of the accounts, the transaction context and the records of the host.
+	/// The accounts are only copied if they were modified since the last snapshot was taken or restored.
+	Snapshot snapshot();
+	/// Restores the state recorded in @a _snapshot. If @a _snapshot shares its accounts with
+	/// the snapshot taken or restored last, only the accounts modified since then are copied.
+	/// @note Only modifications made through the host interface are tracked, i.e. direct changes
+	/// to `accounts` have to be done before taking the snapshot.
+	void restore(Snapshot const& _snapshot);
 	void newBlock()
 	{
 		tx_context.block_number++;
@@ -74,6 +103,14 @@ public:
 		return evmc::MockedHost::account_exists(_addr);
 	}
 
+	evmc_storage_status set_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final;
+
+	evmc_access_status access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept final;
+
 	void selfdestruct(evmc::address const& _addr, evmc::address const& _beneficiary) noexcept final;
 
 	evmc::result call(evmc_message const& _message) noexcept final;
@@ -92,7 +129,24 @@ public:
 	}
 
 private:
+	/// Values of the accounts before their first modification in a call frame,
+	/// nullopt for accounts that did not exist.
+	using AccountJournal = std::unordered_map<evmc::address, std::optional<evmc::MockedAccount>>;
+
 	evmc::address m_currentAddress = {};
+	/// Journals of the active call frames, innermost last.
+	std::vector<AccountJournal> m_journal;
+	/// Accounts of the snapshot taken or restored last.
+	std::shared_ptr<Accounts const> m_accountsSnapshot;
+	/// Addresses of the accounts modified since m_accountsSnapshot was taken or restored.
+	std::unordered_set<evmc::address> m_modifiedAccounts;
+
+	/// Records that the account at @a _address is about to be modified.
+	void journalAccount(evmc::address const& _address);
+	/// Undoes the modifications of the accounts made in the innermost call frame and ends it.
+	void revertCallFrame();
+	/// Ends the innermost call frame, keeping its modifications.
+	void commitCallFrame();
 
 	void transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept;
 
@@ -0,0 +1,184 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the snapshots and the call frame journal of the EVM host.
+ */
+
+#include <test/EVMHost.h>
+
+#include <test/Common.h>
+#include <test/libsolidity/SolidityExecutionFramework.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace solidity::test
+{
+
+BOOST_FIXTURE_TEST_SUITE(EVMHostTest, solidity::frontend::test::SolidityExecutionFramework)
+
+BOOST_AUTO_TEST_CASE(snapshot_and_restore)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			mapping(uint => uint) public m;
+			function set(uint _x) public { x = _x; m[_x] = _x; }
+			function create() public returns (address) { return address(new D()); }
+			function setAndRevert(uint _x) public { x = _x; new D(); revert(); }
+		}
+		contract D {}
+	)";
+	compileAndRun(sourceCode, 0, "C");
+	ABI_CHECK(callContractFunction("set(uint256)", 1), encodeArgs());
+	EVMHost::Snapshot const snapshot = m_evmcHost->snapshot();
+	size_t const accountCount = m_evmcHost->accounts.size();
+	u256 const blockNumber = this->blockNumber();
+
+	for (u256 i = 2; i < 5; ++i)
+	{
+		ABI_CHECK(callContractFunction("set(uint256)", i), encodeArgs());
+		BOOST_CHECK(callContractFunction("create()").size() == 32);
+		BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount + 1);
+		ABI_CHECK(callContractFunction("setAndRevert(uint256)", i + 1), encodeArgs());
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(i));
+		BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount + 1);
+
+		m_evmcHost->restore(snapshot);
+		BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount);
+		BOOST_CHECK_EQUAL(this->blockNumber(), blockNumber);
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(1));
+		ABI_CHECK(callContractFunction("m(uint256)", i), encodeArgs(0));
+	}
+
+	ABI_CHECK(callContractFunction("set(uint256)", 7), encodeArgs());
+	EVMHost::Snapshot const later = m_evmcHost->snapshot();
+	m_evmcHost->restore(snapshot);
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(1));
+	m_evmcHost->restore(later);
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(7));
+	ABI_CHECK(callContractFunction("m(uint256)", 7), encodeArgs(7));
+}
+
+BOOST_AUTO_TEST_CASE(restore_snapshot_twice)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			mapping(uint => uint) public m;
+			function set(uint _x) public { x = _x; m[_x] = _x; }
+			function create() public returns (address) { return address(new D()); }
+		}
+		contract D {}
+	)";
+	compileAndRun(sourceCode, 0, "C");
+	ABI_CHECK(callContractFunction("set(uint256)", 1), encodeArgs());
+	EVMHost::Snapshot const snapshot = m_evmcHost->snapshot();
+	size_t const accountCount = m_evmcHost->accounts.size();
+
+	ABI_CHECK(callContractFunction("set(uint256)", 2), encodeArgs());
+	BOOST_CHECK(callContractFunction("create()").size() == 32);
+	m_evmcHost->restore(snapshot);
+	// Restoring again without any changes in between keeps the restored state.
+	m_evmcHost->restore(snapshot);
+	BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount);
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(1));
+	ABI_CHECK(callContractFunction("m(uint256)", 2), encodeArgs(0));
+
+	// The second restore also undoes changes to accounts that the first one did not touch.
+	BOOST_CHECK(callContractFunction("create()").size() == 32);
+	BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount + 1);
+	ABI_CHECK(callContractFunction("set(uint256)", 3), encodeArgs());
+	m_evmcHost->restore(snapshot);
+	BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount);
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(1));
+	ABI_CHECK(callContractFunction("m(uint256)", 3), encodeArgs(0));
+	ABI_CHECK(callContractFunction("m(uint256)", 1), encodeArgs(1));
+}
+
+BOOST_AUTO_TEST_CASE(reverted_create2)
+{
+	if (!solidity::test::CommonOptions::get().evmVersion().hasCreate2())
+		return;
+
+	char const* sourceCode = R"(
+		contract C {
+			function createAndRevert(bytes32 _salt) external { new D{salt: _salt}(); revert(); }
+			function create(bytes32 _salt) public returns (address) {
+				try this.createAndRevert(_salt) {} catch {}
+				return address(new D{salt: _salt}());
+			}
+		}
+		contract D {}
+	)";
+	compileAndRun(sourceCode, 0, "C");
+	size_t const accountCount = m_evmcHost->accounts.size();
+
+	callContractFunction("createAndRevert(bytes32)", u256(1));
+	BOOST_CHECK(!m_transactionSuccessful);
+	BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount);
+
+	// The address of the reverted creation is free again, also within the same transaction.
+	bytes const address = callContractFunction("create(bytes32)", u256(1));
+	BOOST_REQUIRE(m_transactionSuccessful);
+	BOOST_CHECK(address != encodeArgs(0));
+	BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount + 1);
+
+	// The successful creation is kept, so the same salt cannot be used again.
+	callContractFunction("create(bytes32)", u256(1));
+	BOOST_CHECK(!m_transactionSuccessful);
+	BOOST_CHECK_EQUAL(m_evmcHost->accounts.size(), accountCount + 1);
+}
+
+BOOST_AUTO_TEST_CASE(reverted_storage_changes)
+{
+	if (!solidity::test::CommonOptions::get().evmVersion().supportsReturndata())
+		return;
+
+	// The cost and the refund of a storage write depend on the original value of the slot,
+	// whether it was written before and whether it was accessed before.
+	// All of this has to be undone when a call frame reverts.
+	char const* sourceCode = R"(
+		contract C {
+			uint public x = 1;
+			function clearAndRevert() external { x = 0; revert(); }
+			function clearCost(bool _afterRevertedClear) public returns (uint gasUsed) {
+				if (_afterRevertedClear)
+					try this.clearAndRevert() {} catch {}
+				uint gasBefore = gasleft();
+				x = 0;
+				gasUsed = gasBefore - gasleft();
+			}
+		}
+	)";
+	compileAndRun(sourceCode, 0, "C");
+	EVMHost::Snapshot const snapshot = m_evmcHost->snapshot();
+
+	bytes const cost = callContractFunction("clearCost(bool)", false);
+	BOOST_REQUIRE(m_transactionSuccessful);
+	m_evmcHost->restore(snapshot);
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(1));
+	ABI_CHECK(callContractFunction("clearCost(bool)", true), cost);
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
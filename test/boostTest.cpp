@@ -285,6 +285,7 @@ test_suite* init_unit_test_suite(int /*argc*/, char* /*argv*/[])
 			for (auto suite: {
 				"ABIDecoderTest",
 				"ABIEncoderTest",
+				"EVMHostTest",
 				"SolidityAuctionRegistrar",
 				"SolidityWallet",
 				"GasMeterTests",
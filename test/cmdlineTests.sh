@@ -193,6 +193,7 @@ import re, sys
 json = open("$stdout_path", "r").read()
 json = re.sub(r"{[^{}]*Warning: This is a pre-release compiler version[^{}]*},?", "", json)
 json = re.sub(r"},\s*]", "}]", json)                  # },] -> }]
+json = re.sub(r",\s*\"errors\":\s*\[\s*\]","",json)  # Remove trailing "errors" array if it's empty
 json = re.sub(r"\"errors\":\s*\[\s*\],?\s*","",json)  # Remove "errors" array if it's not empty
 json = re.sub("\n\\s+\n", "\n\n", json)               # Remove any leftover trailing whitespace
 open("$stdout_path", "w").write(json)
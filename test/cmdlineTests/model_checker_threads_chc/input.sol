@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+contract test {
+	uint x;
+	function f(uint y) public {
+		require(y < 100);
+		x = y;
+		assert(x < 100);
+	}
+	function g(uint a) public pure returns (uint) {
+		require(a > 5);
+		assert(a != 0);
+		return 10 / a;
+	}
+}
@@ -1026,6 +1026,76 @@ BOOST_AUTO_TEST_CASE(yul_function_with_whitespace)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(long_whitespace_and_comments)
+{
+	// Runs longer than the blocks the scanner processes at once.
+	string const padding(37, ' ');
+	string const text(53, 'x');
+	TestScanner scanner(
+		padding + "\t\n" + padding + "a" +
+		"// " + text + "\n" +
+		"/* " + text + "*" + text + " */" + padding + "b" +
+		"/// " + text + "\n" + padding + "/// " + text + "\n" +
+		"c" + padding
+	);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a");
+	BOOST_CHECK_EQUAL(scanner.currentLocation().start, 76);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "c");
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), text + "\n " + text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(long_multiline_doc_comment)
+{
+	string const text(40, 'x');
+	TestScanner scanner("/**\n * " + text + " ** " + text + "\n *\n * " + text + "\n */ a");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), " " + text + " ** " + text + "\n " + text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(irregular_line_break_after_long_single_line_comment)
+{
+	string const text(40, 'x');
+	for (auto const& nl: {"\v", "\f", "\xE2\x80\xA8", "\xE2\x80\xA9"})
+	{
+		TestScanner scanner("// " + text + "\xC2\xA0\xE2\x82\xAC" + text + string(nl) + " def ");
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+		BOOST_CHECK_EQUAL(scanner.currentLocation().start, 88);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(direction_override_in_long_comment)
+{
+	string const text(40, 'x');
+	TestScanner scanner("/* " + text + "\xE2\x80\xAE" + text + " */ a");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::DirectionalOverrideMismatch);
+	scanner.reset("/* " + text + "\xE2\x80\xAE" + text + "\xE2\x80\xAC */ a");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+}
+
+BOOST_AUTO_TEST_CASE(long_string_literals)
+{
+	string const text(40, 'x');
+	TestScanner scanner("\"" + text + "\\n" + text + "\" '" + text + "\"'");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text + "\n" + text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text + "\"");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+	scanner.reset("\"" + text + "\x7f" + text + "\"");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalCharacterInString);
+	scanner.reset("unicode\"" + text + "\xE2\x82\xAC" + text + "\"");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::UnicodeStringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text + "\xE2\x82\xAC" + text);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
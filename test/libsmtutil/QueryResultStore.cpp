@@ -0,0 +1,170 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the persistent store of SMT query results.
+ */
+
+#include <libsmtutil/QueryResultStore.h>
+
+#include <test/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <thread>
+
+using namespace std;
+using namespace solidity::util;
+using namespace solidity::test;
+
+namespace fs = boost::filesystem;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+using StoredResult = optional<pair<CheckResult, vector<string>>>;
+
+void writeFile(fs::path const& _path, string const& _content)
+{
+	ofstream file(_path.string(), ios::binary);
+	file << _content;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(QueryResultStoreTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(query_keys)
+{
+	h256 key = QueryResultStore::key("(check-sat)", "z3", 1000);
+	BOOST_CHECK(key == QueryResultStore::key("(check-sat)", "z3", 1000));
+	BOOST_CHECK(key != QueryResultStore::key("(check-sat) ", "z3", 1000));
+	BOOST_CHECK(key != QueryResultStore::key("(check-sat)", "cvc4", 1000));
+	BOOST_CHECK(key != QueryResultStore::key("(check-sat)", "z3", 2000));
+	BOOST_CHECK(key != QueryResultStore::key("(check-sat)", "z3", nullopt));
+}
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	TemporaryDirectory tempDir("smt-store-test");
+	// The directory is created when the first result is stored.
+	QueryResultStore store(tempDir.path() / "results");
+	h256 satKey = QueryResultStore::key("sat query", "z3", nullopt);
+	h256 unsatKey = QueryResultStore::key("unsat query", "z3", nullopt);
+
+	BOOST_CHECK(store.load(satKey) == nullopt);
+
+	store.store(satKey, CheckResult::SATISFIABLE, {"1", "(- 2)", ""});
+	store.store(unsatKey, CheckResult::UNSATISFIABLE, {});
+	BOOST_CHECK(store.load(satKey) == StoredResult(make_pair(CheckResult::SATISFIABLE, vector<string>{"1", "(- 2)", ""})));
+	BOOST_CHECK(store.load(unsatKey) == StoredResult(make_pair(CheckResult::UNSATISFIABLE, vector<string>{})));
+
+	// Another store on the same directory sees the results.
+	BOOST_CHECK(QueryResultStore(tempDir.path() / "results").load(unsatKey) == store.load(unsatKey));
+
+	// Storing again replaces the result.
+	store.store(satKey, CheckResult::SATISFIABLE, {"3"});
+	BOOST_CHECK(store.load(satKey) == StoredResult(make_pair(CheckResult::SATISFIABLE, vector<string>{"3"})));
+}
+
+BOOST_AUTO_TEST_CASE(unstorable_results)
+{
+	TemporaryDirectory tempDir("smt-store-test");
+	QueryResultStore store(tempDir.path());
+	h256 key = QueryResultStore::key("query", "z3", nullopt);
+
+	for (CheckResult result: {CheckResult::UNKNOWN, CheckResult::CONFLICTING, CheckResult::ERROR})
+	{
+		store.store(key, result, {});
+		BOOST_CHECK(store.load(key) == nullopt);
+	}
+
+	// Values are stored one per line, so values containing newlines cannot be stored.
+	store.store(key, CheckResult::SATISFIABLE, {"1", "(let ((a 1))\n a)"});
+	BOOST_CHECK(store.load(key) == nullopt);
+	BOOST_CHECK(fs::is_empty(tempDir.path()));
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_files)
+{
+	TemporaryDirectory tempDir("smt-store-test");
+	QueryResultStore store(tempDir.path());
+	h256 key = QueryResultStore::key("query", "z3", nullopt);
+	fs::path path = tempDir.path() / key.hex();
+
+	for (string const content: {"", "\n", "sat", "unsat\n1", "maybe\n", "SAT\n", "sat\r\n"})
+	{
+		writeFile(path, content);
+		BOOST_CHECK_MESSAGE(store.load(key) == nullopt, content);
+	}
+
+	writeFile(path, "sat\n1\n");
+	BOOST_CHECK(store.load(key) == StoredResult(make_pair(CheckResult::SATISFIABLE, vector<string>{"1"})));
+
+	// A directory in place of the file can neither be read nor replaced.
+	fs::remove(path);
+	fs::create_directory(path);
+	BOOST_CHECK(store.load(key) == nullopt);
+	store.store(key, CheckResult::UNSATISFIABLE, {});
+	BOOST_CHECK(fs::is_directory(path));
+	BOOST_CHECK_EQUAL(distance(fs::directory_iterator(tempDir.path()), fs::directory_iterator()), 1);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_writers)
+{
+	TemporaryDirectory tempDir("smt-store-test");
+	size_t const threadCount = 8;
+	size_t const keyCount = 16;
+	size_t const rounds = 20;
+
+	auto keyAt = [](size_t _index) { return QueryResultStore::key("query " + to_string(_index), "z3", nullopt); };
+	auto valuesAt = [](size_t _index) { return vector<string>(_index, to_string(_index)); };
+
+	// All threads write the same results for the same keys and read them back concurrently.
+	// Readers must never see a partially written file.
+	vector<thread> threads;
+	vector<size_t> failures(threadCount, 0);
+	for (size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+		threads.emplace_back([&, threadIndex]() {
+			QueryResultStore store(tempDir.path());
+			for (size_t round = 0; round < rounds; ++round)
+				for (size_t keyIndex = 0; keyIndex < keyCount; ++keyIndex)
+				{
+					store.store(keyAt(keyIndex), CheckResult::SATISFIABLE, valuesAt(keyIndex));
+					if (store.load(keyAt(keyIndex)) != StoredResult(make_pair(CheckResult::SATISFIABLE, valuesAt(keyIndex))))
+						++failures[threadIndex];
+				}
+		});
+	for (thread& t: threads)
+		t.join();
+
+	BOOST_CHECK(failures == vector<size_t>(threadCount, 0));
+	// No temporary files are left behind.
+	BOOST_CHECK_EQUAL(static_cast<size_t>(distance(fs::directory_iterator(tempDir.path()), fs::directory_iterator())), keyCount);
+	QueryResultStore store(tempDir.path());
+	for (size_t keyIndex = 0; keyIndex < keyCount; ++keyIndex)
+		BOOST_CHECK(store.load(keyAt(keyIndex)) == StoredResult(make_pair(CheckResult::SATISFIABLE, valuesAt(keyIndex))));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,217 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for solvers racing each other in the SMT portfolio.
+ */
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+using namespace std;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+using Result = pair<CheckResult, vector<string>>;
+
+/// What happened to a fake solver, also observable after the solver is destroyed.
+struct SolverLog
+{
+	/// Waits until @a _condition holds, or gives up after a while so that a failing test does not hang.
+	/// @returns false if it gave up.
+	bool waitUntil(function<bool(SolverLog const&)> _condition)
+	{
+		unique_lock<mutex> lock(logMutex);
+		return changed.wait_for(lock, chrono::seconds(30), [&]() { return _condition(*this); });
+	}
+
+	void update(function<void(SolverLog&)> _change)
+	{
+		{
+			lock_guard<mutex> lock(logMutex);
+			_change(*this);
+		}
+		changed.notify_all();
+	}
+
+	size_t startedChecks = 0;
+	size_t finishedChecks = 0;
+	bool interrupted = false;
+
+	mutex logMutex;
+	condition_variable changed;
+};
+
+/// A solver that gives the same result to every query. A blocking solver only returns
+/// UNKNOWN once it is interrupted. Otherwise the query can wait for another solver first.
+class FakeSolver: public SolverInterface
+{
+public:
+	FakeSolver(Result _result, shared_ptr<SolverLog> _log, function<void(size_t)> _beforeAnswer = {}):
+		m_result(move(_result)), m_log(move(_log)), m_beforeAnswer(move(_beforeAnswer))
+	{}
+	static unique_ptr<FakeSolver> blocking(shared_ptr<SolverLog> _log)
+	{
+		auto solver = make_unique<FakeSolver>(Result{CheckResult::UNKNOWN, {}}, _log);
+		solver->m_beforeAnswer = [_log](size_t) { _log->waitUntil([](SolverLog const& _state) { return _state.interrupted; }); };
+		return solver;
+	}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	Result check(vector<Expression> const&) override
+	{
+		size_t checkIndex = 0;
+		m_log->update([&](SolverLog& _log) { checkIndex = _log.startedChecks++; });
+		if (m_beforeAnswer)
+			m_beforeAnswer(checkIndex);
+		m_log->update([](SolverLog& _log) { ++_log.finishedChecks; });
+		if (m_result.first == CheckResult::ERROR)
+			BOOST_THROW_EXCEPTION(SolverError() << util::errinfo_comment("Fake solver error."));
+		return m_result;
+	}
+
+	void interrupt() override
+	{
+		m_log->update([](SolverLog& _log) { _log.interrupted = true; });
+	}
+
+private:
+	Result m_result;
+	shared_ptr<SolverLog> m_log;
+	function<void(size_t)> m_beforeAnswer;
+};
+
+/// @returns a hook that lets a query wait until the solver logged to @a _log finished the same query.
+function<void(size_t)> after(shared_ptr<SolverLog> _log)
+{
+	return [_log](size_t _checkIndex) {
+		_log->waitUntil([&](SolverLog const& _state) { return _state.finishedChecks > _checkIndex; });
+	};
+}
+
+SMTPortfolio makePortfolio(unique_ptr<SolverInterface> _first, unique_ptr<SolverInterface> _second)
+{
+	vector<unique_ptr<SolverInterface>> solvers;
+	solvers.emplace_back(move(_first));
+	solvers.emplace_back(move(_second));
+	return SMTPortfolio(move(solvers), nullopt, 2);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(first_unsat_wins)
+{
+	auto blockedLog = make_shared<SolverLog>();
+	auto unsatLog = make_shared<SolverLog>();
+	{
+		// The first query of the blocked solver starts before the other solver answers.
+		auto portfolio = makePortfolio(
+			FakeSolver::blocking(blockedLog),
+			make_unique<FakeSolver>(Result{CheckResult::UNSATISFIABLE, {}}, unsatLog, [=](size_t) {
+				blockedLog->waitUntil([](SolverLog const& _state) { return _state.startedChecks > 0; });
+			})
+		);
+		for (size_t i = 0; i < 10; ++i)
+			BOOST_CHECK(portfolio.check({}) == Result(CheckResult::UNSATISFIABLE, {}));
+		// Destroying the portfolio interrupts the blocked query instead of waiting for it.
+	}
+	BOOST_CHECK(blockedLog->interrupted);
+	BOOST_CHECK_EQUAL(unsatLog->finishedChecks, 10);
+	// The queries that were queued behind the blocked one never started.
+	BOOST_CHECK_EQUAL(blockedLog->startedChecks, 1);
+	BOOST_CHECK_EQUAL(blockedLog->finishedChecks, 1);
+}
+
+BOOST_AUTO_TEST_CASE(sat_values_do_not_depend_on_timing)
+{
+	Result const firstSat{CheckResult::SATISFIABLE, {"1"}};
+	Result const secondSat{CheckResult::SATISFIABLE, {"2"}};
+	for (size_t round = 0; round < 10; ++round)
+	{
+		// The values of the first solver are used even if the second one is faster.
+		auto firstLog = make_shared<SolverLog>();
+		auto secondLog = make_shared<SolverLog>();
+		auto portfolio = makePortfolio(
+			make_unique<FakeSolver>(firstSat, firstLog, after(secondLog)),
+			make_unique<FakeSolver>(secondSat, secondLog)
+		);
+		BOOST_CHECK(portfolio.check({}) == firstSat);
+		BOOST_CHECK(portfolio.check({}) == firstSat);
+		BOOST_CHECK_EQUAL(secondLog->finishedChecks, 2);
+
+		// If the first one is faster, the second one does not need to finish.
+		auto blockedLog = make_shared<SolverLog>();
+		auto otherPortfolio = makePortfolio(
+			make_unique<FakeSolver>(firstSat, make_shared<SolverLog>()),
+			FakeSolver::blocking(blockedLog)
+		);
+		BOOST_CHECK(otherPortfolio.check({}) == firstSat);
+
+		// The values of a later solver are used if the first one does not answer.
+		auto unknownLog = make_shared<SolverLog>();
+		auto satLog = make_shared<SolverLog>();
+		auto thirdPortfolio = makePortfolio(
+			make_unique<FakeSolver>(Result{CheckResult::UNKNOWN, {}}, unknownLog, after(satLog)),
+			make_unique<FakeSolver>(secondSat, satLog)
+		);
+		BOOST_CHECK(thirdPortfolio.check({}) == secondSat);
+		BOOST_CHECK_EQUAL(unknownLog->finishedChecks, 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(no_answer)
+{
+	auto unknownAndError = makePortfolio(
+		make_unique<FakeSolver>(Result{CheckResult::UNKNOWN, {}}, make_shared<SolverLog>()),
+		make_unique<FakeSolver>(Result{CheckResult::ERROR, {}}, make_shared<SolverLog>())
+	);
+	// Errors of solvers are reported if no solver answered.
+	BOOST_CHECK_THROW(unknownAndError.check({}), SolverError);
+
+	auto errorAndUnsat = makePortfolio(
+		make_unique<FakeSolver>(Result{CheckResult::ERROR, {}}, make_shared<SolverLog>()),
+		make_unique<FakeSolver>(Result{CheckResult::UNSATISFIABLE, {}}, make_shared<SolverLog>())
+	);
+	BOOST_CHECK(errorAndUnsat.check({}) == Result(CheckResult::UNSATISFIABLE, {}));
+
+	auto unknowns = makePortfolio(
+		make_unique<FakeSolver>(Result{CheckResult::UNKNOWN, {}}, make_shared<SolverLog>()),
+		make_unique<FakeSolver>(Result{CheckResult::UNKNOWN, {}}, make_shared<SolverLog>())
+	);
+	BOOST_CHECK(unknowns.check({}) == Result(CheckResult::UNKNOWN, {}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,126 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the sharing of expression arguments and their translation to z3.
+ */
+
+#include <libsmtutil/SolverInterface.h>
+#ifdef HAVE_Z3
+#include <libsmtutil/Z3Interface.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(Z3InterfaceTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(shared_arguments)
+{
+	Expression const a("a", {}, SortProvider::sintSort);
+	Expression const b("b", {}, SortProvider::sintSort);
+	Expression const v("f", {a, b}, SortProvider::sintSort);
+	SharedVector<Expression> copy = v.arguments;
+	BOOST_CHECK(copy.identity() == v.arguments.identity());
+	BOOST_CHECK_EQUAL(copy.size(), 2);
+	BOOST_CHECK_EQUAL(copy[1].name, "b");
+
+	// Modifying a copy detaches it from the shared elements.
+	for (Expression& argument: copy)
+		argument.name += "'";
+	BOOST_CHECK(copy.identity() != v.arguments.identity());
+	BOOST_CHECK_EQUAL(v.arguments[0].name, "a");
+	BOOST_CHECK_EQUAL(copy[0].name, "a'");
+
+	BOOST_CHECK(SharedVector<Expression>().identity() == nullptr);
+	BOOST_CHECK(SharedVector<Expression>(vector<Expression>{}).empty());
+}
+
+#ifdef HAVE_Z3
+
+BOOST_AUTO_TEST_CASE(translation_cache)
+{
+	if (!Z3Interface::available())
+		return;
+
+	Z3Interface z3Interface;
+	z3Interface.declareVariable("x", SortProvider::sintSort);
+	Expression const x("x", {}, SortProvider::sintSort);
+
+	Expression const sum = x + Expression(size_t(1));
+	z3::expr sumTerm = z3Interface.toZ3Expr(sum);
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 1);
+
+	// Both arguments share the elements of sum, which are translated only once.
+	Expression const product = sum * sum;
+	z3::expr productTerm = z3Interface.toZ3Expr(product);
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 2);
+	BOOST_CHECK(z3::eq(productTerm.arg(0), sumTerm));
+	BOOST_CHECK(z3::eq(productTerm.arg(1), sumTerm));
+
+	// Copies share the arguments and give the same term without translating again.
+	Expression const productCopy = product;
+	BOOST_CHECK(z3::eq(z3Interface.toZ3Expr(productCopy), productTerm));
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 2);
+
+	// Equal expressions that are built independently are translated again, to the same term.
+	Expression const otherSum = x + Expression(size_t(1));
+	BOOST_CHECK(z3::eq(z3Interface.toZ3Expr(otherSum * otherSum), productTerm));
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 4);
+
+	// The operator is part of the key.
+	Expression difference = sum;
+	difference.name = "-";
+	BOOST_CHECK(difference.arguments.identity() == sum.arguments.identity());
+	BOOST_CHECK(z3::eq(z3Interface.toZ3Expr(difference), sumTerm.arg(0) - sumTerm.arg(1)));
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(translation_cache_invalidation)
+{
+	if (!Z3Interface::available())
+		return;
+
+	Z3Interface z3Interface;
+	z3Interface.declareVariable("x", SortProvider::sintSort);
+	Expression const x("x", {}, SortProvider::sintSort);
+	Expression const equality = x == x;
+	BOOST_CHECK(z3Interface.toZ3Expr(equality).arg(0).is_int());
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 1);
+
+	// After a reset, the same expression refers to the new declaration.
+	z3Interface.reset();
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 0);
+	z3Interface.declareVariable("x", SortProvider::boolSort);
+	BOOST_CHECK(z3Interface.toZ3Expr(equality).arg(0).is_bool());
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 1);
+
+	// Redeclaring a variable also invalidates the cache.
+	z3Interface.declareVariable("x", SortProvider::sintSort);
+	BOOST_CHECK_EQUAL(z3Interface.translationCacheSize(), 0);
+	BOOST_CHECK(z3Interface.toZ3Expr(equality).arg(0).is_int());
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -251,6 +251,19 @@ bool ASTJSONTest::runTest(
 		ostringstream result;
 		ASTJsonConverter(_compiler.state(), _sourceIndices).print(result, _compiler.ast(m_sources[i].first), JsonFormat{ JsonFormat::Pretty });
 		_variant.result += result.str();
+
+		ostringstream streamedCompact;
+		ASTJsonConverter converter(_compiler.state(), _sourceIndices);
+		converter.print(streamedCompact, _compiler.ast(m_sources[i].first), JsonFormat{ JsonFormat::Compact });
+		if (streamedCompact.str() != jsonCompactPrint(converter.toJson(_compiler.ast(m_sources[i].first))))
+		{
+			AnsiColorized(_stream, _formatted, {BOLD, RED}) <<
+				_linePrefix <<
+				"Streamed AST differs from the result of toJson() for " <<
+				m_sources[i].first <<
+				endl;
+			return false;
+		}
 		if (i != m_sources.size() - 1)
 			_variant.result += ",";
 		_variant.result += "\n";
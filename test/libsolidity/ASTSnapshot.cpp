@@ -0,0 +1,175 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the binary AST snapshot format.
+ */
+
+#include <test/Common.h>
+
+#include <liblangutil/Exceptions.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/ASTSnapshot.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <range/v3/view/map.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+map<string, string> const sources{
+	{"a.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "b.sol";
+		/// @title A
+		contract A is B {
+			event E(uint indexed x, string s);
+			function f(uint _x) public returns (int) {
+				assembly { let y := add(_x, 1) }
+				emit E(_x, unicode"\x00 unicode: ä");
+				return -int(_x) * 2 ** 200;
+			}
+		}
+	)"},
+	{"b.sol", R"(
+		pragma solidity >=0.0;
+		struct S { bytes32 h; address[] a; }
+		abstract contract B { mapping(uint => S) m; bool constant c = true; uint8 constant d = 0xff; }
+	)"}
+};
+
+/// @returns the JSON ASTs of all sources after the compiler stack reached @a _stopAfter.
+map<string, Json::Value> sourceASTs(CompilerStack::State _stopAfter)
+{
+	CompilerStack c;
+	c.setSources(sources);
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(c.parseAndAnalyze(_stopAfter));
+	map<string, Json::Value> result;
+	for (string const& sourceName: c.sourceNames())
+		result[sourceName] = ASTJsonConverter(c.state(), c.sourceIndices()).toJson(c.ast(sourceName));
+	return result;
+}
+
+/// @returns the JSON ASTs after importing and analyzing @a _sourceASTs.
+map<string, string> reimport(map<string, Json::Value> const& _sourceASTs)
+{
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.importASTs(_sourceASTs);
+	BOOST_REQUIRE(c.analyze());
+	map<string, string> result;
+	for (string const& sourceName: c.sourceNames())
+		result[sourceName] = util::jsonCompactPrint(
+			ASTJsonConverter(c.state(), c.sourceIndices()).toJson(c.ast(sourceName))
+		);
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTSnapshotTest)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	for (auto stopAfter: {CompilerStack::State::Parsed, CompilerStack::State::CompilationSuccessful})
+	{
+		map<string, Json::Value> const asts = sourceASTs(stopAfter);
+		string const snapshot = ASTSnapshot::encode(asts);
+		BOOST_REQUIRE(ASTSnapshot::isSnapshot(snapshot));
+
+		map<string, Json::Value> const decoded = ASTSnapshot::decode(snapshot);
+		BOOST_REQUIRE_EQUAL(decoded.size(), asts.size());
+		for (auto const& [sourceName, ast]: asts)
+		{
+			BOOST_REQUIRE(decoded.count(sourceName));
+			BOOST_CHECK_EQUAL(util::jsonCompactPrint(decoded.at(sourceName)), util::jsonCompactPrint(ast));
+			BOOST_CHECK(decoded.at(sourceName) == ast);
+		}
+
+		size_t jsonSize = 0;
+		for (auto const& ast: asts | ranges::views::values)
+		{
+			string const json = util::jsonCompactPrint(ast);
+			BOOST_CHECK(!ASTSnapshot::isSnapshot(json));
+			jsonSize += json.size();
+		}
+		BOOST_CHECK_LT(snapshot.size(), jsonSize);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(import_matches_json_import)
+{
+	map<string, Json::Value> const asts = sourceASTs(CompilerStack::State::Parsed);
+
+	map<string, Json::Value> parsedFromJson;
+	for (auto const& [sourceName, ast]: asts)
+		BOOST_REQUIRE(util::jsonParseStrict(util::jsonCompactPrint(ast), parsedFromJson[sourceName]));
+
+	BOOST_CHECK(reimport(ASTSnapshot::decode(ASTSnapshot::encode(asts))) == reimport(parsedFromJson));
+}
+
+BOOST_AUTO_TEST_CASE(invalid_snapshots)
+{
+	string const snapshot = ASTSnapshot::encode(sourceASTs(CompilerStack::State::Parsed));
+
+	BOOST_CHECK_THROW(ASTSnapshot::decode(""), InvalidAstError);
+	BOOST_CHECK_THROW(ASTSnapshot::decode("{\"sources\":{}}"), InvalidAstError);
+	BOOST_CHECK_THROW(ASTSnapshot::decode(snapshot.substr(0, snapshot.size() - 1)), InvalidAstError);
+	BOOST_CHECK_THROW(ASTSnapshot::decode(snapshot + "x"), InvalidAstError);
+
+	string otherVersion = snapshot;
+	otherVersion[7] = static_cast<char>(ASTSnapshot::version + 1);
+	BOOST_CHECK_THROW(ASTSnapshot::decode(otherVersion), InvalidAstError);
+
+	// A single source "a" containing _depth nested arrays of size one around null.
+	auto nestedArrays = [](size_t _depth) {
+		string encodedAST;
+		for (size_t i = 0; i < _depth; ++i)
+			encodedAST += "\x07\x01";
+		encodedAST += '\0';
+		string result("\0solast", 7);
+		result += static_cast<char>(ASTSnapshot::version);
+		result += "\x01\x01" "a" "\x01\x00"s;
+		for (size_t length = encodedAST.size(); ; length >>= 7)
+		{
+			result += static_cast<char>((length & 0x7f) | (length >= 0x80 ? 0x80 : 0));
+			if (length < 0x80)
+				break;
+		}
+		return result + encodedAST;
+	};
+	BOOST_CHECK_EQUAL(ASTSnapshot::decode(nestedArrays(100)).at("a")[0][0][0].size(), 1);
+	BOOST_CHECK_THROW(ASTSnapshot::decode(nestedArrays(1000000)), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -25,9 +25,12 @@
 #include <test/Common.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
+#include <libsolutil/JSON.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <string>
@@ -113,6 +116,73 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_parsing_matches_sequential_parsing)
+{
+	map<string, string> const files{
+		{"lib/a.sol", "import \"lib/b.sol\"; contract A is B { function f() public { assembly { let x := 1 } } } pragma solidity >=0.0;"},
+		{"lib/b.sol", "import \"lib/c.sol\"; contract B is C {} pragma solidity >=0.0;"},
+		{"lib/c.sol", "contract C { uint x; } pragma solidity >=0.0;"}
+	};
+	ReadCallback::Callback readFile = [&](string const& _kind, string const& _path) {
+		BOOST_REQUIRE(_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile));
+		if (files.count(_path))
+			return ReadCallback::Result{true, files.at(_path)};
+		return ReadCallback::Result{false, "Not found."};
+	};
+
+	auto parse = [&](unsigned _threads) {
+		CompilerStack c(readFile);
+		c.setThreads(_threads);
+		c.setSources({
+			{"main.sol", "import \"lib/a.sol\"; contract Main is A {} pragma solidity >=0.0;"},
+			{"other.sol", "import \"lib/c.sol\"; import \"missing.sol\"; contract Other is C { function g() public {} } pragma solidity >=0.0;"},
+			{"plain.sol", "contract Plain { function h() public pure returns (uint) { return 1; } } pragma solidity >=0.0;"}
+		});
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.parse();
+
+		string result;
+		for (auto const& error: c.errors())
+			result += error->what() + "\n"s;
+		for (string const& sourceName: c.sourceNames())
+			result += sourceName + ": " + util::jsonCompactPrint(
+				ASTJsonConverter(c.state(), c.sourceIndices()).toJson(c.ast(sourceName))
+			) + "\n";
+		return result;
+	};
+
+	string const sequentialResult = parse(1);
+	BOOST_CHECK_EQUAL(parse(4), sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_analysis_reports_errors_in_source_order)
+{
+	auto analyze = [&](unsigned _threads) {
+		CompilerStack c;
+		c.setThreads(_threads);
+		c.setSources({
+			{"a.sol", "contract A { function f() public { continue; } }"},
+			{"b.sol", "import \"a.sol\"; /// @unknown tag\ncontract B is A {} pragma solidity >=0.0;"},
+			{"c.sol", "contract C { /// @notice x\n/// @author y\nfunction g() public { break; } } pragma solidity >=0.0;"},
+			{"d.sol", "contract D {} pragma solidity >=0.0;"}
+		});
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		BOOST_CHECK(!c.parseAndAnalyze());
+
+		string result;
+		for (auto const& error: c.errors())
+		{
+			if (langutil::SourceLocation const* location = error->sourceLocation())
+				result += *location->sourceName + ":" + to_string(location->start) + ": ";
+			result += error->what() + "\n"s;
+		}
+		return result;
+	};
+
+	string const sequentialResult = analyze(1);
+	BOOST_CHECK_EQUAL(analyze(4), sequentialResult);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -22,8 +22,12 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libsolutil/Parallel.h>
+
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 using namespace std;
 
 namespace solidity::frontend::test
@@ -51,6 +55,87 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(caches_contract_artifacts)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function f(uint a) public pure returns (uint) { return a + 1; }
+		}
+	)";
+	BOOST_REQUIRE(success(sourceCode));
+	BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contract failed");
+	// Compilation already requested the metadata and the artifacts it contains.
+	auto before = compiler().artifactCacheStatistics();
+
+	Json::Value const& abi = compiler().contractABI("C");
+	BOOST_CHECK_EQUAL(&compiler().contractABI("C"), &abi);
+	Json::Value const& gasEstimates = compiler().gasEstimates("C");
+	BOOST_CHECK_EQUAL(&compiler().gasEstimates("C"), &gasEstimates);
+	Json::Value const& assemblyJSON = compiler().assemblyJSON("C");
+	BOOST_CHECK_EQUAL(&compiler().assemblyJSON("C"), &assemblyJSON);
+	string const* sourceMapping = compiler().sourceMapping("C");
+	BOOST_REQUIRE(sourceMapping);
+	BOOST_CHECK_EQUAL(compiler().sourceMapping("C"), sourceMapping);
+
+	// The assembly is only cached for the source codes of the first request.
+	StringMap const sourceCodes{{"", compiler().charStream("").source()}};
+	string const assembly = compiler().assemblyString("C", sourceCodes);
+	BOOST_CHECK_EQUAL(compiler().assemblyString("C", sourceCodes), assembly);
+	BOOST_CHECK(compiler().assemblyString("C") != assembly);
+	BOOST_CHECK_EQUAL(compiler().assemblyString("C", sourceCodes), assembly);
+
+	auto after = compiler().artifactCacheStatistics();
+	BOOST_CHECK_EQUAL(after["abi"].misses, before["abi"].misses);
+	BOOST_CHECK_EQUAL(after["abi"].hits, before["abi"].hits + 2);
+	for (string const output: {"evm.gasEstimates", "evm.legacyAssembly", "evm.bytecode.sourceMap"})
+	{
+		BOOST_CHECK_EQUAL(after[output].misses, before[output].misses + 1);
+		BOOST_CHECK_EQUAL(after[output].hits, before[output].hits + 1);
+	}
+	BOOST_CHECK_EQUAL(after["evm.assembly"].misses, before["evm.assembly"].misses + 2);
+	BOOST_CHECK_EQUAL(after["evm.assembly"].hits, before["evm.assembly"].hits + 2);
+
+	compiler().reset();
+	for (auto const& [output, statistics]: compiler().artifactCacheStatistics())
+	{
+		BOOST_CHECK_EQUAL(statistics.hits, 0);
+		BOOST_CHECK_EQUAL(statistics.misses, 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(computes_contract_artifacts_once_when_requested_concurrently)
+{
+	char const* sourceCode = R"(
+		contract C {
+			event E(uint);
+			error Err(uint);
+			function f(uint a) public returns (uint) { emit E(a); return a; }
+			function g() public pure { revert Err(1); }
+		}
+	)";
+	BOOST_REQUIRE(success(sourceCode));
+	BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contract failed");
+
+	size_t const requests = 8;
+	vector<Json::Value const*> gasEstimates(requests);
+	vector<Json::Value const*> interfaceSymbols(requests);
+	util::parallelFor(requests, requests, [&](size_t _index) {
+		gasEstimates[_index] = &compiler().gasEstimates("C");
+		interfaceSymbols[_index] = &compiler().interfaceSymbols("C");
+	});
+	for (size_t i = 1; i < requests; ++i)
+	{
+		BOOST_CHECK_EQUAL(gasEstimates[i], gasEstimates[0]);
+		BOOST_CHECK_EQUAL(interfaceSymbols[i], interfaceSymbols[0]);
+	}
+
+	auto statistics = compiler().artifactCacheStatistics();
+	BOOST_CHECK_EQUAL(statistics["evm.gasEstimates"].misses, 1);
+	BOOST_CHECK_EQUAL(statistics["evm.gasEstimates"].hits, requests - 1);
+	BOOST_CHECK_EQUAL(statistics["evm.methodIdentifiers"].misses, 1);
+	BOOST_CHECK_EQUAL(statistics["evm.methodIdentifiers"].hits, requests - 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
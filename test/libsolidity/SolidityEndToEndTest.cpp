@@ -4120,6 +4120,39 @@ BOOST_AUTO_TEST_CASE(strip_reason_strings)
 	)
 }
 
+BOOST_AUTO_TEST_CASE(identical_compilation_input_is_compiled_once)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			constructor(uint _x) { x = _x; }
+		}
+		contract D {
+			function f() public pure returns (uint) { return 7; }
+		}
+	)";
+	ALSO_VIA_YUL(
+		DISABLE_EWASM_TESTRUN()
+		size_t const misses = compilationCacheStatistics().misses;
+		size_t const hits = compilationCacheStatistics().hits;
+
+		compileAndRun(sourceCode, 0, "C", encodeArgs(1));
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(1));
+		compileAndRun(sourceCode, 0, "C", encodeArgs(2));
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(2));
+		compileAndRun(sourceCode, 0, "D");
+		ABI_CHECK(callContractFunction("f()"), encodeArgs(7));
+		BOOST_CHECK_EQUAL(compilationCacheStatistics().misses, misses + 1);
+		BOOST_CHECK_EQUAL(compilationCacheStatistics().hits, hits + 2);
+
+		m_revertStrings = RevertStrings::Strip;
+		compileAndRun(sourceCode, 0, "D");
+		ABI_CHECK(callContractFunction("f()"), encodeArgs(7));
+		BOOST_CHECK_EQUAL(compilationCacheStatistics().misses, misses + 2);
+		m_revertStrings = RevertStrings::Default;
+	)
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -29,8 +29,10 @@
 
 #include <boost/test/framework.hpp>
 
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <tuple>
 
 using namespace solidity;
 using namespace solidity::frontend;
@@ -48,26 +50,69 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 {
 	if (_mainSourceName.has_value())
 		solAssert(_sourceCode.find(_mainSourceName.value()) != _sourceCode.end(), "");
-	map<string, string> sourcesWithPreamble = _sourceCode;
-	for (auto& entry: sourcesWithPreamble)
+	CompilationInput input{
+		_sourceCode,
+		_libraryAddresses,
+		m_evmVersion,
+		m_optimiserSettings,
+		m_compileViaYul,
+		m_compileToEwasm,
+		m_revertStrings,
+		m_metadataHash
+	};
+	for (auto& entry: input.sources)
 		entry.second = addPreamble(entry.second);
 
+	if (isCompiled(input))
+	{
+		++compilationCacheStatistics().hits;
+		compilationCacheStatistics().secondsSaved += m_compiledInputSeconds;
+	}
+	else
+		compileSources(move(input));
+
+	string contractName(_contractName.empty() ? m_compiler.lastContractName(_mainSourceName) : _contractName);
+	auto cachedObject = m_compiledObjects.find(contractName);
+	if (cachedObject == m_compiledObjects.end())
+		cachedObject = m_compiledObjects.emplace(contractName, contractObject(contractName, _libraryAddresses)).first;
+	evmasm::LinkerObject const& obj = cachedObject->second;
+	BOOST_REQUIRE(obj.linkReferences.empty());
+	if (m_showMetadata)
+		cout << "metadata: " << m_compiler.metadata(contractName) << endl;
+	return obj.bytecode;
+}
+
+void SolidityExecutionFramework::compileSources(CompilationInput _input)
+{
+	m_compiledInput.reset();
+	m_compiledObjects.clear();
+	++compilationCacheStatistics().misses;
+	auto const start = chrono::steady_clock::now();
+
 	m_compiler.reset();
-	m_compiler.enableEwasmGeneration(m_compileToEwasm);
-	m_compiler.setSources(sourcesWithPreamble);
-	m_compiler.setLibraries(_libraryAddresses);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	m_compiler.setEVMVersion(m_evmVersion);
-	m_compiler.setOptimiserSettings(m_optimiserSettings);
-	m_compiler.enableEvmBytecodeGeneration(!m_compileViaYul);
-	m_compiler.enableIRGeneration(m_compileViaYul);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	m_compiler.setMetadataHash(m_metadataHash);
-	if (!m_compiler.compile())
+	m_compiler.enableEwasmGeneration(_input.compileToEwasm);
+	m_compiler.setSources(_input.sources);
+	m_compiler.setLibraries(_input.libraries);
+	m_compiler.setRevertStringBehaviour(_input.revertStrings);
+	m_compiler.setEVMVersion(_input.evmVersion);
+	m_compiler.setOptimiserSettings(_input.optimiserSettings);
+	m_compiler.enableEvmBytecodeGeneration(!_input.compileViaYul);
+	m_compiler.enableIRGeneration(_input.compileViaYul);
+	m_compiler.setMetadataHash(_input.metadataHash);
+	bool const success = m_compiler.compile();
+
+	chrono::duration<double> const duration = chrono::steady_clock::now() - start;
+	compilationCacheStatistics().secondsCompiling += duration.count();
+	if (success)
+	{
+		m_compiledInput = move(_input);
+		m_compiledInputSeconds = duration.count();
+	}
+	else
 	{
 		// The testing framework expects an exception for
 		// "unimplemented" yul IR generation.
-		if (m_compileViaYul)
+		if (_input.compileViaYul)
 			for (auto const& error: m_compiler.errors())
 				if (error->type() == langutil::Error::Type::CodeGenerationError)
 					BOOST_THROW_EXCEPTION(*error);
@@ -75,12 +120,18 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 			.printErrorInformation(m_compiler.errors());
 		BOOST_ERROR("Compiling contract failed");
 	}
-	string contractName(_contractName.empty() ? m_compiler.lastContractName(_mainSourceName) : _contractName);
+}
+
+evmasm::LinkerObject SolidityExecutionFramework::contractObject(
+	string const& _contractName,
+	map<string, Address> const& _libraryAddresses
+)
+{
 	evmasm::LinkerObject obj;
 	if (m_compileViaYul)
 	{
 		if (m_compileToEwasm)
-			obj = m_compiler.ewasmObject(contractName);
+			obj = m_compiler.ewasmObject(_contractName);
 		else
 		{
 			// Try compiling twice: If the first run fails due to stack errors, forcefully enable
@@ -103,7 +154,7 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 					optimiserSettings,
 					DebugInfoSelection::All()
 				);
-				bool analysisSuccessful = asmStack.parseAndAnalyze("", m_compiler.yulIROptimized(contractName));
+				bool analysisSuccessful = asmStack.parseAndAnalyze("", m_compiler.yulIROptimized(_contractName));
 				solAssert(analysisSuccessful, "Code that passed analysis in CompilerStack can't have errors");
 
 				try
@@ -122,11 +173,8 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 		}
 	}
 	else
-		obj = m_compiler.object(contractName);
-	BOOST_REQUIRE(obj.linkReferences.empty());
-	if (m_showMetadata)
-		cout << "metadata: " << m_compiler.metadata(contractName) << endl;
-	return obj.bytecode;
+		obj = m_compiler.object(_contractName);
+	return obj;
 }
 
 bytes SolidityExecutionFramework::compileContract(
@@ -157,3 +205,41 @@ string SolidityExecutionFramework::addPreamble(string const& _sourceCode)
 		preamble += "pragma abicoder v1;\n";
 	return preamble + _sourceCode;
 }
+
+SolidityExecutionFramework::CompilationCacheStatistics& SolidityExecutionFramework::compilationCacheStatistics()
+{
+	static CompilationCacheStatistics statistics;
+	return statistics;
+}
+
+bool SolidityExecutionFramework::CompilationInput::operator==(CompilationInput const& _other) const
+{
+	auto tied = [](CompilationInput const& _input) {
+		return tie(
+			_input.sources,
+			_input.libraries,
+			_input.evmVersion,
+			_input.optimiserSettings,
+			_input.compileViaYul,
+			_input.compileToEwasm,
+			_input.revertStrings,
+			_input.metadataHash
+		);
+	};
+	return tied(*this) == tied(_other);
+}
+
+bool SolidityExecutionFramework::isCompiled(CompilationInput const& _input) const
+{
+	if (!m_compiledInput || !(*m_compiledInput == _input))
+		return false;
+
+	// Tests may also use m_compiler directly, so check that it still holds this compilation.
+	vector<string> const sourceNames = m_compiler.sourceNames();
+	if (m_compiler.state() != CompilerStack::CompilationSuccessful || sourceNames.size() != _input.sources.size())
+		return false;
+	for (auto const& [name, source]: _input.sources)
+		if (!util::contains(sourceNames, name) || m_compiler.charStream(name).source() != source)
+			return false;
+	return true;
+}
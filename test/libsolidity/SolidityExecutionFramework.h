@@ -24,6 +24,9 @@
 #pragma once
 
 #include <functional>
+#include <map>
+#include <optional>
+#include <string>
 
 #include <test/ExecutionFramework.h>
 
@@ -74,9 +77,67 @@ public:
 	/// Returns @param _sourceCode prefixed with the version pragma and the abi coder v1 pragma,
 	/// the latter only if it is forced.
 	static std::string addPreamble(std::string const& _sourceCode);
+
+	/// Counters for the reuse of compilation results by multiSourceCompileContract(), summed over all
+	/// instances in the process.
+	struct CompilationCacheStatistics
+	{
+		/// Number of compilations that were skipped because the input was compiled last.
+		size_t hits = 0;
+		/// Number of compilations that were performed.
+		size_t misses = 0;
+		/// Time spent in the compilations that were performed.
+		double secondsCompiling = 0.0;
+		/// Time the skipped compilations took when their input was compiled.
+		double secondsSaved = 0.0;
+
+		CompilationCacheStatistics& operator+=(CompilationCacheStatistics const& _other) noexcept
+		{
+			hits += _other.hits;
+			misses += _other.misses;
+			secondsCompiling += _other.secondsCompiling;
+			secondsSaved += _other.secondsSaved;
+			return *this;
+		}
+	};
+	static CompilationCacheStatistics& compilationCacheStatistics();
+
 protected:
 	using CompilerStack = solidity::frontend::CompilerStack;
+
+	/// Sources and settings of a compilation by multiSourceCompileContract().
+	struct CompilationInput
+	{
+		std::map<std::string, std::string> sources;
+		std::map<std::string, solidity::test::Address> libraries;
+		langutil::EVMVersion evmVersion;
+		OptimiserSettings optimiserSettings;
+		bool compileViaYul = false;
+		bool compileToEwasm = false;
+		RevertStrings revertStrings = RevertStrings::Default;
+		CompilerStack::MetadataHash metadataHash = CompilerStack::MetadataHash::IPFS;
+
+		bool operator==(CompilationInput const& _other) const;
+	};
+
+	/// @returns true if m_compiler holds the successful compilation of @a _input.
+	bool isCompiled(CompilationInput const& _input) const;
+	/// Compiles @a _input with m_compiler and remembers it in m_compiledInput if successful.
+	void compileSources(CompilationInput _input);
+	/// @returns the linked bytecode of the contract @a _contractName from m_compiler.
+	evmasm::LinkerObject contractObject(
+		std::string const& _contractName,
+		std::map<std::string, solidity::test::Address> const& _libraryAddresses
+	);
+
 	CompilerStack m_compiler;
+	/// Input of the last successful compilation by multiSourceCompileContract() and the time it took.
+	/// As long as m_compiler is not changed otherwise, the next request with the same input is
+	/// answered from m_compiler and m_compiledObjects.
+	std::optional<CompilationInput> m_compiledInput;
+	double m_compiledInputSeconds = 0.0;
+	/// Bytecode of the contracts of m_compiledInput by contract name.
+	std::map<std::string, evmasm::LinkerObject> m_compiledObjects;
 	bool m_compileViaYul = false;
 	bool m_compileToEwasm = false;
 	bool m_showMetadata = false;
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -1090,6 +1091,89 @@ BOOST_AUTO_TEST_CASE(evm_version)
 	BOOST_CHECK(result["errors"][0]["message"].asString() == "Invalid EVM version requested.");
 }
 
+BOOST_AUTO_TEST_CASE(additional_evm_versions)
+{
+	auto input = [](string const& _source, string const& _versions)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { "fileA": { "content": ")" + _source + R"(" } },
+				"settings": {
+					)" + _versions + R"(
+					"outputSelection": {
+						"fileA": {
+							"A": [ "metadata", "evm.bytecode.object", "evm.deployedBytecode.object" ]
+						}
+					}
+				}
+			}
+		)";
+	};
+	string const source =
+		"contract A { function f() public view returns (uint r) { r = block.chainid; assembly { r := add(r, selfbalance()) } } }";
+
+	Json::Value result = compile(input(source, R"("evmVersion": "london", "additionalEVMVersions": ["istanbul", "berlin", "london"],)"));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK(contract["additionalEVMVersions"].getMemberNames() == (vector<string>{"berlin", "istanbul"}));
+
+	// Every target gets the same code as when compiling for it alone.
+	for (string const version: {"london", "berlin", "istanbul"})
+	{
+		Json::Value const& versionOutput = version == "london" ? contract : contract["additionalEVMVersions"][version];
+		BOOST_CHECK(versionOutput["metadata"].asString().find("\"evmVersion\":\"" + version + "\"") != string::npos);
+
+		Json::Value separateResult = compile(input(source, "\"evmVersion\": \"" + version + "\","));
+		BOOST_REQUIRE(containsAtMostWarnings(separateResult));
+		Json::Value separateContract = getContractResult(separateResult, "fileA", "A");
+		BOOST_CHECK_EQUAL(versionOutput["metadata"].asString(), separateContract["metadata"].asString());
+		BOOST_CHECK_EQUAL(versionOutput["evm"]["bytecode"]["object"].asString(), separateContract["evm"]["bytecode"]["object"].asString());
+		BOOST_CHECK_EQUAL(versionOutput["evm"]["deployedBytecode"]["object"].asString(), separateContract["evm"]["deployedBytecode"]["object"].asString());
+	}
+
+	// Only features available on all targets can be used.
+	result = compile(input(
+		"contract A { function f() public view returns (uint) { return block.basefee; } }",
+		R"("evmVersion": "london", "additionalEVMVersions": ["istanbul"],)"
+	));
+	BOOST_CHECK(containsError(result, "TypeError", "\"basefee\" is not supported by the VM version."));
+
+	result = compile(input(source, R"("evmVersion": "london", "additionalEVMVersions": ["homestead"],)"));
+	BOOST_CHECK(containsError(result, "JSONError", "Additional EVM versions have to be byzantium or newer if and only if evmVersion is."));
+	result = compile(input(source, R"("additionalEVMVersions": ["invalid"],)"));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid EVM version requested."));
+	result = compile(input(source, R"("additionalEVMVersions": "istanbul",)"));
+	BOOST_CHECK(containsError(result, "JSONError", "additionalEVMVersions must be an array of strings."));
+}
+
+BOOST_AUTO_TEST_CASE(additional_evm_versions_codegen_warnings_reported_once)
+{
+	// The runtime code contains the string, which exceeds the code size limit.
+	string const input = R"(
+		{
+			"language": "Solidity",
+			"sources": { "fileA": { "content": "contract A { function f() public pure returns (string memory) { return \")" +
+				string(25000, 'a') +
+				R"(\"; } }" } },
+			"settings": {
+				"evmVersion": "london",
+				"additionalEVMVersions": ["istanbul", "berlin"],
+				"outputSelection": { "fileA": { "A": [ "evm.deployedBytecode.object" ] } }
+			}
+		}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	size_t codeSizeWarnings = 0;
+	for (Json::Value const& error: result["errors"])
+		if (error["message"].asString().find("exceeds 24576 bytes") != string::npos)
+			++codeSizeWarnings;
+	BOOST_CHECK_EQUAL(codeSizeWarnings, 1);
+	BOOST_CHECK_EQUAL(getContractResult(result, "fileA", "A")["additionalEVMVersions"].size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(optimizer_settings_default_disabled)
 {
 	char const* input = R"(
@@ -1810,6 +1894,98 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output_matches_json_output)
+{
+	vector<string> const inputs{
+		R"({
+			"language": "Solidity",
+			"sources": {
+				"a.sol2": { "content": "pragma solidity >=0.0; contract B { function g() public pure { uint unused; } }" },
+				"a.sol": { "content": "pragma solidity >=0.0; import \"a.sol2\"; contract C is B {} contract A { event E(uint indexed x); }" },
+				"b.sol": { "content": "pragma solidity >=0.0; library L { function f() external {} }" }
+			},
+			"settings": { "outputSelection": { "*": { "*": ["*"], "": ["ast"] } } }
+		})",
+		R"({
+			"language": "Solidity",
+			"sources": { "a.sol": { "content": "contract A { function f() public { x = 1; } }" } },
+			"settings": { "outputSelection": { "*": { "*": ["abi"], "": ["ast"] } } }
+		})",
+		R"({
+			"language": "Yul",
+			"sources": { "a.yul": { "content": "{ sstore(0, 1) }" } },
+			"settings": { "outputSelection": { "*": { "*": ["*"] } } }
+		})",
+		R"({ "language": "Fortran", "sources": {} })",
+		"not json",
+	};
+
+	for (util::JsonFormat const& format: {util::JsonFormat{}, util::JsonFormat{util::JsonFormat::Pretty}})
+		for (string const& input: inputs)
+		{
+			string const streamed = solidity::frontend::StandardCompiler({}, format).compile(input);
+			Json::Value parsedOutput;
+			BOOST_REQUIRE(util::jsonParseStrict(streamed, parsedOutput));
+			Json::Value parsedInput;
+			if (util::jsonParseStrict(input, parsedInput))
+			{
+				// The streamed output only differs in the position of "errors", which is written last.
+				// Both are compared after parsing, because parsing does not preserve the signedness of numbers.
+				string const output = util::jsonPrint(
+					solidity::frontend::StandardCompiler({}, format).compile(parsedInput),
+					format
+				);
+				Json::Value parsedJsonOutput;
+				BOOST_REQUIRE(util::jsonParseStrict(output, parsedJsonOutput));
+				BOOST_CHECK_MESSAGE(parsedOutput == parsedJsonOutput, streamed + "\n" + output);
+			}
+		}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_internal_error_after_sources)
+{
+	/// Fails with an internal error once all sources have been written.
+	class FailingOutputSink: public solidity::frontend::StandardCompiler::StreamOutputSink
+	{
+	public:
+		using StreamOutputSink::StreamOutputSink;
+		void finish() override { solAssert(false, "Failure after sources."); }
+	};
+
+	Json::Value input;
+	BOOST_REQUIRE(util::jsonParseStrict(R"({
+		"language": "Solidity",
+		"sources": {
+			"a.sol": { "content": "pragma solidity >=0.0; contract A { function f() public pure { uint unused; } }" },
+			"b.sol": { "content": "pragma solidity >=0.0; contract B {}" }
+		},
+		"settings": { "outputSelection": { "*": { "*": ["abi"], "": ["ast"] } } }
+	})", input));
+
+	for (util::JsonFormat const& format: {util::JsonFormat{}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		ostringstream stream;
+		FailingOutputSink output(stream, format);
+		solidity::frontend::StandardCompiler().compile(input, output);
+
+		Json::Value parsedOutput;
+		string errors;
+		BOOST_REQUIRE_MESSAGE(util::jsonParseStrict(stream.str(), parsedOutput, &errors), errors + "\n" + stream.str());
+		BOOST_CHECK(parsedOutput["contracts"]["a.sol"].isMember("A"));
+		BOOST_CHECK(parsedOutput["contracts"]["b.sol"].isMember("B"));
+		BOOST_CHECK(parsedOutput["sources"]["a.sol"].isMember("ast"));
+		BOOST_CHECK(parsedOutput["sources"]["b.sol"].isMember("ast"));
+		// The warnings of the compilation and the internal error are reported together.
+		Json::Value const& errorList = parsedOutput["errors"];
+		BOOST_REQUIRE(errorList.size() > 1);
+		for (Json::ArrayIndex i = 0; i + 1 < errorList.size(); ++i)
+			BOOST_CHECK_EQUAL(errorList[i]["type"].asString(), "Warning");
+		Json::Value const& internalError = errorList[errorList.size() - 1];
+		BOOST_CHECK_EQUAL(internalError["type"].asString(), "InternalCompilerError");
+		BOOST_CHECK(internalError["message"].asString().find("Failure after sources.") != string::npos);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
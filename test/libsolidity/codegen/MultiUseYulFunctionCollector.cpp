@@ -0,0 +1,136 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/codegen/MultiUseYulFunctionCollector.h
+
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <string>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Requests shared functions from a collector like YulUtilFunctions does:
+/// "f" uses "g" and "h", "g" uses "h". Counts how often the code of each function is generated.
+class Helpers
+{
+public:
+	explicit Helpers(MultiUseYulFunctionCollector& _collector): m_collector(_collector) {}
+
+	string f()
+	{
+		return m_collector.createSharedFunction("f", [&]() {
+			++generated["f"];
+			return "function f() { " + g() + "() " + h() + "() }\n";
+		});
+	}
+	string g()
+	{
+		return m_collector.createSharedFunction("g", [&](vector<string>& _args, vector<string>& _rets) {
+			++generated["g"];
+			_args = {"x"};
+			_rets = {"y"};
+			return "y := " + h() + "(x)";
+		});
+	}
+	string h()
+	{
+		return m_collector.createSharedFunction("h", [&]() {
+			++generated["h"];
+			return string("function h() {}\n");
+		});
+	}
+
+	map<string, size_t> generated;
+
+private:
+	MultiUseYulFunctionCollector& m_collector;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(MultiUseYulFunctionCollectorTest)
+
+BOOST_AUTO_TEST_CASE(shared_functions_are_generated_once_per_cache)
+{
+	MultiUseYulFunctionCache cache;
+	EVMVersion evmVersion;
+
+	MultiUseYulFunctionCollector first(&cache, evmVersion, RevertStrings::Default);
+	Helpers firstHelpers(first);
+	firstHelpers.f();
+	string const firstCode = first.requestedFunctions();
+	BOOST_CHECK_EQUAL(cache.size(), 3);
+
+	MultiUseYulFunctionCollector second(&cache, evmVersion, RevertStrings::Default);
+	Helpers secondHelpers(second);
+	secondHelpers.f();
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), firstCode);
+	BOOST_CHECK(secondHelpers.generated.empty());
+
+	// Functions generated with other settings are not shared.
+	MultiUseYulFunctionCollector debug(&cache, evmVersion, RevertStrings::Debug);
+	Helpers debugHelpers(debug);
+	debugHelpers.f();
+	BOOST_CHECK_EQUAL(debug.requestedFunctions(), firstCode);
+	BOOST_CHECK_EQUAL(debugHelpers.generated["f"], 1);
+	BOOST_CHECK_EQUAL(cache.size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(cached_functions_keep_the_order_of_generation)
+{
+	MultiUseYulFunctionCache cache;
+	EVMVersion evmVersion;
+
+	MultiUseYulFunctionCollector warmUp(&cache, evmVersion, RevertStrings::Default);
+	Helpers(warmUp).f();
+	warmUp.requestedFunctions();
+
+	// Requests in different orders and with some functions already present must give the same
+	// code as without the cache.
+	for (string const order: {"f", "hf", "gf", "ghf", "fg"})
+	{
+		MultiUseYulFunctionCollector uncached;
+		MultiUseYulFunctionCollector cached(&cache, evmVersion, RevertStrings::Default);
+		Helpers uncachedHelpers(uncached);
+		Helpers cachedHelpers(cached);
+		for (char function: order)
+			for (Helpers* helpers: {&uncachedHelpers, &cachedHelpers})
+				switch (function)
+				{
+				case 'f': helpers->f(); break;
+				case 'g': helpers->g(); break;
+				case 'h': helpers->h(); break;
+				}
+		BOOST_CHECK_EQUAL(cached.requestedFunctions(), uncached.requestedFunctions());
+		BOOST_CHECK(cachedHelpers.generated.empty());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+import "./lib.sol";
+
+contract C
+{
+    uint counter;
+    //   ^^^^^^^ @counterDeclaration
+
+    function increment(uint by) public returns (uint)
+    {
+        counter += by;
+    //  ^^^^^^^ @counterInIncrement
+        return counter;
+        //     ^^^^^^^ @counterInReturn
+    }
+
+    function useLib(uint n) public payable returns (uint)
+    {
+        return Lib.add(n, 1);
+        //         ^^^ @addInUseLib
+    }
+}
+// ----
+// lib: @diagnostics 2072
+// -> textDocument/references {
+//     "position": @counterInReturn,
+//     "context": {
+//         "includeDeclaration": true
+//     }
+// }
+// <- [
+//     {
+//         "range": @counterDeclaration,
+//         "uri": "find_references.sol"
+//     },
+//     {
+//         "range": @counterInIncrement,
+//         "uri": "find_references.sol"
+//     },
+//     {
+//         "range": @counterInReturn,
+//         "uri": "find_references.sol"
+//     }
+// ]
+// -> textDocument/references {
+//     "position": @addInUseLib
+// }
+// <- [
+//     {
+//         "range": @addInUseLib,
+//         "uri": "find_references.sol"
+//     }
+// ]
+// -> textDocument/references {
+//     "position": @counterDeclaration,
+//     "context": {
+//         "includeDeclaration": false
+//     }
+// }
+// <- [
+//     {
+//         "range": @counterInIncrement,
+//         "uri": "find_references.sol"
+//     },
+//     {
+//         "range": @counterInReturn,
+//         "uri": "find_references.sol"
+//     }
+// ]
@@ -0,0 +1,35 @@
+contract C {
+    uint value1;
+    uint value2;
+    uint other;
+    uint XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX;
+    uint ZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZ;
+    uint WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW;
+    function f() public view {
+        valeu1;
+        value3;
+        othr;
+        valeu1;
+        value3;
+        othr;
+        valeu1;
+        value3;
+        othr;
+        XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX;
+        ZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZ;
+        WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW;
+    }
+}
+// ----
+// DeclarationError 7576: (375-381): Undeclared identifier. Did you mean "value1" or "value2"?
+// DeclarationError 7576: (391-397): Undeclared identifier. Did you mean "value1" or "value2"?
+// DeclarationError 7576: (407-411): Undeclared identifier. Did you mean "other"?
+// DeclarationError 7576: (421-427): Undeclared identifier. Did you mean "value1" or "value2"?
+// DeclarationError 7576: (437-443): Undeclared identifier. Did you mean "value1" or "value2"?
+// DeclarationError 7576: (453-457): Undeclared identifier. Did you mean "other"?
+// DeclarationError 7576: (467-473): Undeclared identifier. Did you mean "value1" or "value2"?
+// DeclarationError 7576: (483-489): Undeclared identifier. Did you mean "value1" or "value2"?
+// DeclarationError 7576: (499-503): Undeclared identifier. Did you mean "other"?
+// DeclarationError 7576: (513-591): Undeclared identifier. Did you mean "XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX"?
+// DeclarationError 7576: (601-680): Undeclared identifier. Did you mean "ZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZZ"?
+// DeclarationError 7576: (690-770): Undeclared identifier.
@@ -118,6 +118,59 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json::Value json;
+	Json::Value jsonChild;
+
+	jsonChild["3.1"] = "3.1";
+	jsonChild["3.2"] = Json::arrayValue;
+	jsonChild["3.3"] = Json::objectValue;
+	json["1"] = 1;
+	json["2"] = Json::nullValue;
+	json["3"] = jsonChild;
+	json["4"] = "ऑ ऒ ओ औ क ख";
+	json["5"].append(jsonChild);
+	json["5"].append(string("\0\n", 2));
+	json["5"].append(Json::arrayValue);
+	json["5"].append(true);
+
+	for (JsonFormat const& format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		ostringstream whole;
+		JsonStreamWriter(whole, format).value(json);
+		BOOST_CHECK_EQUAL(whole.str(), jsonPrint(json, format));
+
+		ostringstream pieces;
+		JsonStreamWriter writer(pieces, format);
+		writer.beginObject();
+		for (string const& key: json.getMemberNames())
+		{
+			writer.key(key);
+			if (json[key].isArray())
+			{
+				writer.beginArray();
+				for (auto const& element: json[key])
+					writer.value(element);
+				writer.endArray();
+			}
+			else
+				writer.value(json[key]);
+		}
+		writer.endObject();
+		BOOST_CHECK_EQUAL(pieces.str(), jsonPrint(json, format));
+	}
+
+	ostringstream empty;
+	JsonStreamWriter writer(empty, JsonFormat{JsonFormat::Pretty});
+	writer.beginObject();
+	writer.key("a");
+	writer.beginArray();
+	writer.endArray();
+	writer.endObject();
+	BOOST_CHECK_EQUAL(empty.str(), "{\n  \"a\": []\n}");
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
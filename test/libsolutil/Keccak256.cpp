@@ -69,6 +69,27 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(incremental)
+{
+	// Longer than two blocks, so that the pieces cross block and lane boundaries.
+	bytes input(300);
+	for (size_t i = 0; i < input.size(); ++i)
+		input[i] = static_cast<uint8_t>(i * 7);
+	h256 const expectation = keccak256(input);
+
+	for (size_t pieceSize: {1u, 3u, 8u, 135u, 136u, 137u, 300u})
+	{
+		Keccak256Hasher hasher;
+		for (size_t offset = 0; offset < input.size(); offset += pieceSize)
+		{
+			BOOST_CHECK_EQUAL(hasher.digest(), keccak256(bytesConstRef(input.data(), offset)));
+			hasher.update(bytesConstRef(&input).cropped(offset, min(pieceSize, input.size() - offset)));
+		}
+		BOOST_CHECK_EQUAL(hasher.digest(), expectation);
+	}
+	BOOST_CHECK_EQUAL(Keccak256Hasher{}.update(string("longer ")).update(string("test string")).digest(), keccak256("longer test string"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
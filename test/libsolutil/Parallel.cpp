@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the parallel execution helpers.
+ */
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(parallel_for_visits_every_index_once)
+{
+	for (unsigned threads: {0u, 1u, 2u, 8u, 100u})
+	{
+		vector<atomic<unsigned>> visits(37);
+		parallelFor(visits.size(), threads, [&](size_t _index) { ++visits[_index]; });
+		for (auto const& count: visits)
+			BOOST_CHECK_EQUAL(count.load(), 1u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_empty_range)
+{
+	bool called = false;
+	parallelFor(0, 4, [&](size_t) { called = true; });
+	BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_sequential_is_ordered)
+{
+	vector<size_t> order;
+	parallelFor(5, 1, [&](size_t _index) { order.push_back(_index); });
+	BOOST_CHECK((order == vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_rethrows_lowest_index_exception)
+{
+	atomic<unsigned> completed{0};
+	try
+	{
+		parallelFor(20, 4, [&](size_t _index) {
+			if (_index == 7 || _index == 13)
+				throw runtime_error(to_string(_index));
+			++completed;
+		});
+		BOOST_FAIL("Expected exception.");
+	}
+	catch (runtime_error const& _exception)
+	{
+		BOOST_CHECK_EQUAL(string(_exception.what()), "7");
+	}
+	BOOST_CHECK_EQUAL(completed.load(), 18u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
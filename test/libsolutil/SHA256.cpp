@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sha256.
+ */
+#include <libsolutil/SHA256.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(SHA256, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	BOOST_CHECK_EQUAL(
+		sha256(bytes()),
+		FixedHash<32>("0xe3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(strings)
+{
+	BOOST_CHECK_EQUAL(
+		sha256("abc"),
+		FixedHash<32>("0xba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")
+	);
+	// 56 bytes: the padding does not fit into the last block.
+	BOOST_CHECK_EQUAL(
+		sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+		FixedHash<32>("0x248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1")
+	);
+	BOOST_CHECK_EQUAL(
+		sha256(string(1000000, 'a')),
+		FixedHash<32>("0xcdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(incremental)
+{
+	bytes input(300);
+	for (size_t i = 0; i < input.size(); ++i)
+		input[i] = static_cast<uint8_t>(i * 7);
+	h256 const expectation = sha256(input);
+
+	for (size_t pieceSize: {1u, 3u, 55u, 63u, 64u, 65u, 300u})
+	{
+		SHA256Hasher hasher;
+		for (size_t offset = 0; offset < input.size(); offset += pieceSize)
+		{
+			BOOST_CHECK_EQUAL(hasher.digest(), sha256(bytesConstRef(input.data(), offset)));
+			hasher.update(bytesConstRef(&input).cropped(offset, min(pieceSize, input.size() - offset)));
+		}
+		BOOST_CHECK_EQUAL(hasher.digest(), expectation);
+	}
+	BOOST_CHECK_EQUAL(SHA256Hasher{}.update(string("ab")).update(string("c")).digest(), sha256("abc"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -29,6 +29,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <set>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -73,6 +75,66 @@ BOOST_AUTO_TEST_CASE(test_dldistance)
 
 }
 
+BOOST_AUTO_TEST_CASE(test_unrestricted_dldistance)
+{
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("hello", "hellw"), 1);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("hello", "helol"), 1);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("hello", "hllllo"), 2);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("a", ""), 1);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("abc", "ba"), 2);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("abcd", "wxyz"), 4);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("", ""), 0);
+	// Inserting between transposed characters is only allowed here.
+	BOOST_CHECK_EQUAL(stringDistance("ca", "abc"), 3);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("ca", "abc"), 2);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("abc", "ca"), 2);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance("abxcdyef", "bacxdfey"), 4);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance(string(1000, 'a') + "bc", string(1000, 'a') + "cb"), 1);
+	BOOST_CHECK_EQUAL(unrestrictedStringDistance(string(1000, 'a'), string(998, 'a')), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_string_distance_index)
+{
+	vector<string> strings{"hello", "hellw", "helol", "world", "word", "hllllo", "abc", "ca", "", "hello"};
+	StringDistanceIndex index;
+	for (string const& str: strings)
+		index.insert(str);
+	BOOST_CHECK_EQUAL(index.size(), strings.size() - 1);
+
+	for (char const* query: {"hello", "wrld", "bac", "", "xyz"})
+		for (size_t maxDistance = 0; maxDistance <= 3; ++maxDistance)
+		{
+			set<string> expected;
+			for (string const& str: strings)
+				if (unrestrictedStringDistance(query, str) <= maxDistance)
+					expected.insert(str);
+			set<string> found;
+			for (string const* str: index.within(query, maxDistance))
+				BOOST_CHECK(found.insert(*str).second);
+			BOOST_CHECK(found == expected);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(test_string_distance_index_length_threshold)
+{
+	StringDistanceIndex index(10 * 10);
+	for (string const& str: {string(10, 'a'), string(11, 'a'), string(12, 'b'), string(11, 'a')})
+		index.insert(str);
+	BOOST_CHECK_EQUAL(index.size(), 3);
+
+	auto within = [&](string const& _query, size_t _maxDistance) {
+		set<string> found;
+		for (string const* str: index.within(_query, _maxDistance))
+			found.insert(*str);
+		return found;
+	};
+	// Strings above the threshold are only found if stringWithinDistance would accept them.
+	BOOST_CHECK(within(string(9, 'a'), 2) == set<string>({string(10, 'a'), string(11, 'a')}));
+	BOOST_CHECK(within(string(10, 'a'), 2) == set<string>({string(10, 'a')}));
+	BOOST_CHECK(within(string(12, 'b'), 0) == set<string>({string(12, 'b')}));
+	BOOST_CHECK(within(string(13, 'a'), 2).empty());
+}
+
 BOOST_AUTO_TEST_CASE(test_alternatives_list)
 {
 	vector<string> strings;
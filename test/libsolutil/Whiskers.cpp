@@ -25,11 +25,106 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <random>
+#include <regex>
+
 using namespace std;
 
 namespace solidity::util::test
 {
 
+namespace
+{
+
+/// @returns the message of the error thrown when rendering @a _whiskers, or nullopt if it renders.
+optional<string> renderError(Whiskers const& _whiskers)
+{
+	try
+	{
+		_whiskers.render();
+	}
+	catch (WhiskersError const& _error)
+	{
+		string const* comment = boost::get_error_info<errinfo_comment>(_error);
+		return comment ? *comment : "";
+	}
+	return nullopt;
+}
+
+/// The regular expression based implementation that the renderer replaced,
+/// kept as a reference for checking that the output and errors did not change.
+string referenceRender(
+	string const& _template,
+	Whiskers::StringMap const& _parameters,
+	map<string, bool> const& _conditions,
+	map<string, vector<Whiskers::StringMap>> const& _listParameters = {}
+)
+{
+	static string const paramRegex = "[a-zA-Z0-9_$-]+";
+	static regex const listOrTag(
+		"<(" + paramRegex + ")>|"
+		"<#(" + paramRegex + ")>((?:.|\\r|\\n)*?)</\\2>|"
+		"<\\?(\\+?" + paramRegex + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
+	);
+	string result;
+	auto lastMatchEnd = _template.cbegin();
+	for (sregex_iterator match(_template.begin(), _template.end(), listOrTag), end; match != end; ++match)
+	{
+		result.append(match->prefix().first, match->prefix().second);
+		lastMatchEnd = (*match)[0].second;
+		string tagName((*match)[1]);
+		string listName((*match)[2]);
+		string conditionName((*match)[4]);
+		if (!tagName.empty())
+		{
+			assertThrow(
+				_parameters.count(tagName),
+				WhiskersError,
+				"Value for tag " + tagName + " not provided.\n" +
+				"Template:\n" +
+				_template
+			);
+			result += _parameters.at(tagName);
+		}
+		else if (!listName.empty())
+		{
+			assertThrow(_listParameters.count(listName), WhiskersError, "List parameter " + listName + " not set.");
+			for (auto const& parameters: _listParameters.at(listName))
+			{
+				Whiskers::StringMap joined = _parameters;
+				for (auto const& parameter: parameters)
+					assertThrow(joined.insert(parameter).second, WhiskersError, "Parameter collision");
+				result += referenceRender((*match)[3], joined, _conditions);
+			}
+		}
+		else
+		{
+			bool conditionValue = false;
+			if (conditionName[0] == '+')
+			{
+				string tag = conditionName.substr(1);
+				if (_parameters.count(tag))
+					conditionValue = !_parameters.at(tag).empty();
+				else if (_listParameters.count(tag))
+					conditionValue = !_listParameters.at(tag).empty();
+				else
+					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
+			}
+			else
+			{
+				assertThrow(_conditions.count(conditionName), WhiskersError, "Condition parameter " + conditionName + " not set.");
+				conditionValue = _conditions.at(conditionName);
+			}
+			result += referenceRender(conditionValue ? (*match)[5] : (*match)[7], _parameters, _conditions, _listParameters);
+		}
+	}
+	result.append(lastMatchEnd, _template.cend());
+	return result;
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(WhiskersTest, *boost::unit_test::label("nooptions"))
 
 BOOST_AUTO_TEST_CASE(no_templates)
@@ -208,6 +303,194 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unclosed_tags)
+{
+	// Tags without their closing tag are copied like text.
+	BOOST_CHECK_EQUAL(Whiskers("<#l>x").render(), "<#l>x");
+	BOOST_CHECK_EQUAL(Whiskers("<?c>x<!c>y").render(), "<?c>x<!c>y");
+	BOOST_CHECK_EQUAL(Whiskers("<?+a>x").render(), "<?+a>x");
+	BOOST_CHECK_EQUAL(Whiskers("<a <b").render(), "<a <b");
+	BOOST_CHECK_EQUAL(Whiskers("x</l></c><!c>").render(), "x</l></c><!c>");
+	BOOST_CHECK_EQUAL(Whiskers("<#l>x</m>").render(), "<#l>x</m>");
+	BOOST_CHECK_EQUAL(Whiskers("<#l>x</#l>").render(), "<#l>x</#l>");
+	// An unclosed tag inside a closed one is copied as well.
+	BOOST_CHECK_EQUAL(Whiskers("<?c><#l>x</c><a>")("c", true)("a", "A").render(), "<#l>xA");
+	// Setting a list or a condition requires its closing tag.
+	BOOST_CHECK_THROW(Whiskers("<#l>x")("l", vector<Whiskers::StringMap>{}), WhiskersError);
+	BOOST_CHECK_THROW(Whiskers("<?c>x")("c", true), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(conditional_else_branches)
+{
+	string templ = "<?b>X<!b>Y<!b>Z</b>";
+	// Only the first else tag separates the branches.
+	BOOST_CHECK_EQUAL(Whiskers(templ)("b", true).render(), "X");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("b", false).render(), "Y<!b>Z");
+	BOOST_CHECK_EQUAL(Whiskers("<?b><!b>Y</b>")("b", true).render(), "");
+	BOOST_CHECK_EQUAL(Whiskers("<?b><!b>Y</b>")("b", false).render(), "Y");
+	BOOST_CHECK_EQUAL(Whiskers("<?b>X<!b></b>")("b", false).render(), "");
+	// The else tag of another condition is part of the branch.
+	BOOST_CHECK_EQUAL(Whiskers("<?a>X<!b>Y</a>")("a", true).render(), "X<!b>Y");
+	BOOST_CHECK_EQUAL(Whiskers("<?a>X<!b>Y</a>")("a", false).render(), "");
+	// An else tag after the closing tag is not part of the condition.
+	BOOST_CHECK_EQUAL(Whiskers("<?b>X</b>Y<!b>")("b", false).render(), "Y<!b>");
+
+	string nested = "<?a>1<?b>2<!b>3</b>4<!a>5<?b>6<!b>7</b>8</a>";
+	for (bool a: {false, true})
+		for (bool b: {false, true})
+			BOOST_CHECK_EQUAL(
+				Whiskers(nested)("a", a)("b", b).render(),
+				a ? (b ? "124" : "134") : (b ? "568" : "578")
+			);
+}
+
+BOOST_AUTO_TEST_CASE(string_and_list_conditions)
+{
+	string templ = "<?+l>[<#l><x></l>]<!+l>none</+l>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("l", vector<Whiskers::StringMap>{{{"x", "1"}}, {{"x", "2"}}}).render(), "[12]");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("l", vector<Whiskers::StringMap>{}).render(), "none");
+	// A list with empty elements is not empty.
+	BOOST_CHECK_EQUAL(Whiskers("<?+l>x</+l><#l></l>")("l", vector<Whiskers::StringMap>(1)).render(), "x");
+
+	// Inside of a list, the condition can refer to the parameters of the element.
+	string elements = "<#l><?+v>(<v>)<!+v>-</+v></l>";
+	BOOST_CHECK_EQUAL(Whiskers(elements)("l", vector<Whiskers::StringMap>{{{"v", "a"}}, {{"v", ""}}}).render(), "(a)-");
+
+	// A condition on a parameter cannot be set as a plain condition.
+	BOOST_CHECK_THROW(Whiskers("<?+a>x</+a>")("+a", true), WhiskersError);
+	BOOST_CHECK_EQUAL(Whiskers("<?+a>x</+a><a>")("a", "").render(), "");
+}
+
+BOOST_AUTO_TEST_CASE(nested_lists)
+{
+	// Conditions and outer parameters are available inside of lists,
+	// but lists are not, so lists cannot be nested.
+	string templ = "<#l><?c><x><a></c></l>";
+	BOOST_CHECK_EQUAL(
+		Whiskers(templ)("a", "A")("c", true)("l", vector<Whiskers::StringMap>{{{"x", "1"}}, {{"x", "2"}}}).render(),
+		"1A2A"
+	);
+	Whiskers nested("<#outer>(<#inner><x></inner>)</outer>");
+	nested("outer", vector<Whiskers::StringMap>(1));
+	nested("inner", vector<Whiskers::StringMap>{{{"x", "1"}}});
+	BOOST_CHECK(renderError(nested) == "List parameter inner not set."s);
+	// An empty outer list never renders the inner one.
+	Whiskers empty("<#outer>(<#inner><x></inner>)</outer>");
+	empty("outer", vector<Whiskers::StringMap>{});
+	BOOST_CHECK_EQUAL(empty.render(), "");
+	// A list ends at its first closing tag.
+	BOOST_CHECK_EQUAL(
+		Whiskers("<#l>[</l>]")("l", vector<Whiskers::StringMap>(2)).render(),
+		"[[]"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(error_messages)
+{
+	BOOST_CHECK(renderError(Whiskers("x<b>")) == "Value for tag b not provided.\nTemplate:\nx<b>"s);
+	BOOST_CHECK(renderError(Whiskers("<#b></b>")) == "List parameter b not set."s);
+	BOOST_CHECK(renderError(Whiskers("<?b></b>")) == "Condition parameter b not set."s);
+	BOOST_CHECK(renderError(Whiskers("<?+b></+b>")) == "Tag b used as condition but was not set."s);
+	// Errors in lists refer to the template of the list element.
+	BOOST_CHECK(
+		renderError(Whiskers("<#l>(<y>)</l>")("l", vector<Whiskers::StringMap>(1))) ==
+		"Value for tag y not provided.\nTemplate:\n(<y>)"s
+	);
+	// Errors are reported for the first failing tag.
+	BOOST_CHECK(renderError(Whiskers("<?c></c><b>")) == "Condition parameter c not set."s);
+	BOOST_CHECK(renderError(Whiskers("<?c>x<b><!c>y</c>")("c", false)) == nullopt);
+
+	auto errorOf = [](function<void()> _action) -> string {
+		try
+		{
+			_action();
+		}
+		catch (WhiskersError const& _error)
+		{
+			return *boost::get_error_info<errinfo_comment>(_error);
+		}
+		return "";
+	};
+	BOOST_CHECK_EQUAL(errorOf([]() { Whiskers("<b>")("c", "x"); }), "Tag '<c>' not found in template:\n<b>");
+	BOOST_CHECK_EQUAL(errorOf([]() { Whiskers("<?b></b>")("b", "x"); }), "Tag '<b>' not found in template:\n<?b></b>");
+	BOOST_CHECK_EQUAL(errorOf([]() { Whiskers("<b><?b></b>")("b", "x")("b", true); }), "b already set as value parameter.");
+	BOOST_CHECK_EQUAL(errorOf([]() { Whiskers("<b><?b></b>")("b", true)("b", "x"); }), "b already set as condition parameter.");
+	BOOST_CHECK_EQUAL(
+		errorOf([]() { Whiskers("<b><#b></b>")("b", vector<Whiskers::StringMap>{})("b", "x"); }),
+		"b already set as list parameter."
+	);
+	BOOST_CHECK_EQUAL(
+		errorOf([]() { Whiskers("<a><#l></l>")("a", "A")("l", vector<Whiskers::StringMap>{{{"a", "x"}}}).render(); }),
+		"Parameter collision"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(same_as_regular_expressions)
+{
+	// Random templates made of tags, broken tags and text render to the same
+	// text or fail with the same error as the previous implementation.
+	vector<string> const fragments{
+		"<a>", "<b>", "<x>", "<#l>", "</l>", "<?c>", "<!c>", "</c>", "<?+a>", "<!+a>", "</+a>",
+		"<?+l>", "<!+l>", "</+l>", "<?l>", "<!l>", "<#c>", "<", ">", "</", "<#", "<?", "<!", "+",
+		"a", "l", "c", "x", "$", "-", " ", "\n", "\r", "<a", "<-x>", "<?c >", "</ c>"
+	};
+	mt19937 random(7);
+	auto chance = [&](unsigned _percent) { return random() % 100 < _percent; };
+	size_t const templateCount = 20000;
+	size_t failures = 0;
+	size_t errors = 0;
+	for (size_t i = 0; i < templateCount; ++i)
+	{
+		string templ;
+		for (size_t length = random() % 12; length > 0; --length)
+			templ += fragments[random() % fragments.size()];
+
+		Whiskers::StringMap parameters;
+		map<string, bool> conditions;
+		map<string, vector<Whiskers::StringMap>> lists;
+		Whiskers whiskers(templ);
+		auto contains = [&](vector<string> const& _tags) {
+			return all_of(_tags.begin(), _tags.end(), [&](string const& _tag) { return templ.find(_tag) != string::npos; });
+		};
+		if (contains({"<a>"}) && chance(80))
+			whiskers("a", parameters["a"] = chance(50) ? "A" : "");
+		if (contains({"<b>"}) && chance(80))
+			whiskers("b", parameters["b"] = "<x>");
+		if (contains({"<?c>", "</c>"}) && chance(80))
+			whiskers("c", conditions["c"] = chance(50));
+		if (contains({"<#l>", "</l>"}) && chance(80))
+		{
+			vector<Whiskers::StringMap> elements(random() % 3);
+			for (auto& element: elements)
+				if (chance(70))
+					element["x"] = "X";
+			whiskers("l", lists["l"] = elements);
+		}
+
+		optional<string> expectedError;
+		string expected;
+		try
+		{
+			expected = referenceRender(templ, parameters, conditions, lists);
+		}
+		catch (WhiskersError const& _error)
+		{
+			expectedError = *boost::get_error_info<errinfo_comment>(_error);
+			++errors;
+		}
+		optional<string> error = renderError(whiskers);
+		if (error != expectedError || (!error && whiskers.render() != expected))
+		{
+			++failures;
+			BOOST_TEST_MESSAGE("Different result for template: " + templ);
+		}
+	}
+	BOOST_CHECK_EQUAL(failures, 0);
+	// Make sure that both outcomes are covered.
+	BOOST_CHECK(errors > templateCount / 10);
+	BOOST_CHECK(errors < templateCount / 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
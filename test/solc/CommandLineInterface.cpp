@@ -146,7 +146,7 @@ BOOST_AUTO_TEST_CASE(version)
 
 BOOST_AUTO_TEST_CASE(multiple_input_modes)
 {
-	array<string, 9> inputModeOptions = {
+	array<string, 10> inputModeOptions = {
 		"--help",
 		"--license",
 		"--version",
@@ -156,10 +156,11 @@ BOOST_AUTO_TEST_CASE(multiple_input_modes)
 		"--strict-assembly",
 		"--yul",
 		"--import-ast",
+		"--server",
 	};
 	string expectedMessage =
 		"The following options are mutually exclusive: "
-		"--help, --license, --version, --standard-json, --link, --assemble, --strict-assembly, --yul, --import-ast, --lsp. "
+		"--help, --license, --version, --standard-json, --link, --assemble, --strict-assembly, --yul, --import-ast, --lsp, --server. "
 		"Select at most one.";
 
 	for (string const& mode1: inputModeOptions)
@@ -1114,6 +1115,50 @@ BOOST_AUTO_TEST_CASE(standard_json_include_paths)
 	BOOST_TEST(result.reader.basePath() == expectedWorkDir / "base/");
 }
 
+BOOST_AUTO_TEST_CASE(server_mode)
+{
+	TemporaryDirectory tempDir({"base/"}, TEST_CASE_NAME);
+	TemporaryWorkingDirectory tempWorkDir(tempDir);
+
+	string const preamble =
+		"// SPDX-License-Identifier: GPL-3.0\n"
+		"pragma solidity >=0.0;\n";
+	createFilesWithParentDirs({tempDir.path() / "base/lib.sol"}, preamble + "contract L {}\n");
+
+	auto standardJsonInput = [](string const& _sourceName) {
+		return
+			R"({"language": "Solidity", "sources": {")" + _sourceName + R"(": {"content": )"
+			R"("pragma solidity >=0.0;\nimport 'lib.sol';\ncontract C is L {}"}}})";
+	};
+
+	OptionsReaderAndMessages result = runCLI(
+		{"solc", "--server", "--base-path=base/"},
+		standardJsonInput("a.sol") + "\n\n" + standardJsonInput("b.sol") + "\n"
+	);
+
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(result.stderrContent == "");
+	BOOST_TEST(result.options.input.mode == InputMode::Server);
+
+	vector<string> outputLines;
+	boost::split(outputLines, result.stdoutContent, boost::is_any_of("\n"));
+	BOOST_REQUIRE(outputLines.size() == 3);
+	BOOST_TEST(outputLines[2] == "");
+	for (auto const& [outputLine, sourceName]: vector<pair<string, string>>{{outputLines[0], "a.sol"}, {outputLines[1], "b.sol"}})
+	{
+		Json::Value parsedOutput;
+		BOOST_REQUIRE(util::jsonParseStrict(outputLine, parsedOutput));
+		for (Json::Value const& errorDict: parsedOutput["errors"])
+			// The error list might contain pre-release compiler warning
+			BOOST_TEST(errorDict["severity"] != "error");
+		BOOST_TEST((parsedOutput["sources"].getMemberNames() | ranges::to<set>) == (set<string>{sourceName, "lib.sol"}));
+	}
+
+	// Sources of finished inputs are dropped, only the file cache is kept.
+	BOOST_TEST(result.reader.sourceUnits().empty());
+	BOOST_TEST(result.reader.fileCacheSize() == preamble.size() + string("contract L {}\n").size());
+}
+
 BOOST_AUTO_TEST_CASE(cli_include_paths_empty_path)
 {
 	TemporaryDirectory tempDir({"base/", "include/"}, TEST_CASE_NAME);
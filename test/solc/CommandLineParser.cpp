@@ -117,6 +117,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--allow-paths=/tmp,/home,project,../contracts",
 			"--ignore-missing",
 			"--error-recovery",
+			"--threads=4",
 			"--output-dir=/tmp/out",
 			"--overwrite",
 			"--evm-version=spuriousDragon",
@@ -131,7 +132,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--libraries="
 				"dir1/file1.sol:L=0x1234567890123456789012345678901234567890,"
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
-			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
+			"--ast-compact-json", "--ast-snapshot", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-optimized", "--ewasm", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
 			"--gas",
 			"--combined-json="
@@ -142,6 +143,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--model-checker-cache-dir=smt-cache",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
@@ -149,6 +151,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--model-checker-show-unproved",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
+			"--model-checker-threads=4",
 			"--model-checker-timeout=5",
 		};
 
@@ -173,6 +176,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.input.allowedDirectories = {"/tmp", "/home", "project", "../contracts", "c", "/usr/lib"};
 		expectedOptions.input.ignoreMissingFiles = true;
 		expectedOptions.input.errorRecovery = (inputMode == InputMode::Compiler);
+		expectedOptions.input.threads = (inputMode == InputMode::Compiler ? 4 : 1);
 		expectedOptions.output.dir = "/tmp/out";
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
@@ -190,7 +194,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true,
+			true, true,
 		};
 		expectedOptions.compiler.outputs.ewasmIR = false;
 		expectedOptions.compiler.estimateGas = true;
@@ -208,6 +212,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
+			"smt-cache",
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
 			true,
 			{true, false},
@@ -215,6 +220,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true,
 			{false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
+			4,
 			5,
 		};
 
@@ -418,6 +424,52 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	BOOST_TEST(parsedOptions == expectedOptions);
 }
 
+BOOST_AUTO_TEST_CASE(server_mode_options)
+{
+	vector<string> commandLine = {
+		"solc",
+		"--server",
+		"--base-path=/home/user/",
+		"--include-path=/usr/lib/include/",
+		"--allow-paths=/tmp,project",
+		"--server-cache-limit=16",
+	};
+
+	CommandLineOptions expectedOptions;
+
+	expectedOptions.input.mode = InputMode::Server;
+	expectedOptions.input.basePath = "/home/user/";
+	expectedOptions.input.includePaths = {"/usr/lib/include/"};
+	expectedOptions.input.allowedDirectories = {"/tmp", "project"};
+	expectedOptions.input.serverCacheLimit = 16 * 1024 * 1024;
+
+	CommandLineOptions parsedOptions = parseCommandLine(commandLine);
+
+	BOOST_TEST(parsedOptions == expectedOptions);
+	BOOST_TEST(parseCommandLine({"solc", "--server"}).input.serverCacheLimit == CommandLineOptions{}.input.serverCacheLimit);
+
+	string expectedMessage = "The following options are not supported in the current input mode: --server-cache-limit";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	for (char const* inputMode: {"--standard-json", "--link", "--yul"})
+		BOOST_CHECK_EXCEPTION(
+			parseCommandLine({"solc", "--server-cache-limit=1", "file", inputMode}),
+			CommandLineValidationError,
+			hasCorrectMessage
+		);
+}
+
+BOOST_AUTO_TEST_CASE(server_mode_rejects_input_files_and_pretty_json)
+{
+	for (vector<string> const& commandLine: vector<vector<string>>{
+		{"solc", "--server", "input.json"},
+		{"solc", "--server", "-"},
+		{"solc", "--server", "a=b"},
+		{"solc", "--server", "--pretty-json"},
+		{"solc", "--server", "--json-indent=2"},
+	})
+		BOOST_CHECK_THROW(parseCommandLine(commandLine), CommandLineValidationError);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 {
 	map<string, vector<string>> invalidOptionInputModeCombinations = {
@@ -70,7 +70,13 @@ void IsolTestOptions::addOptions()
 		("help", po::bool_switch(&showHelp)->default_value(showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor)->default_value(noColor), "Don't use colors.")
 		("accept-updates", po::bool_switch(&acceptUpdates)->default_value(acceptUpdates), "Automatically accept expectation updates.")
-		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
+		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.")
+		(
+			"jobs,j",
+			po::value<size_t>(&jobs)->default_value(jobs),
+			"Number of test cases to run concurrently in separate processes. "
+			"Failing test cases are run again sequentially to update them interactively."
+		);
 }
 
 bool IsolTestOptions::parse(int _argc, char const* const* _argv)
@@ -98,6 +104,10 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs must be at least 1.");
+#if defined(_WIN32)
+	assertThrow(jobs == 1, ConfigException, "Running test cases concurrently is not supported on Windows.");
+#endif
 }
 
 }
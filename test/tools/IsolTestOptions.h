@@ -34,6 +34,8 @@ struct IsolTestOptions: CommonOptions
 	bool acceptUpdates = false;
 	std::string testFilter = std::string{};
 	std::string editor = std::string{};
+	/// Number of test cases that are run concurrently in separate processes.
+	size_t jobs = 1;
 
 	explicit IsolTestOptions();
 	void addOptions() override;
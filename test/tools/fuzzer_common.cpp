@@ -103,6 +103,7 @@ void FuzzerUtil::testCompiler(
 	{
 		forceSMT(_input);
 		compiler.setModelCheckerSettings({
+			/*cacheDirectory=*/std::nullopt,
 			frontend::ModelCheckerContracts::Default(),
 			/*divModWithSlacks*/true,
 			frontend::ModelCheckerEngine::All(),
@@ -110,6 +111,7 @@ void FuzzerUtil::testCompiler(
 			/*showUnproved=*/false,
 			smtutil::SMTSolverChoice::All(),
 			frontend::ModelCheckerTargets::Default(),
+			/*threads=*/1,
 			/*timeout=*/1
 		});
 	}
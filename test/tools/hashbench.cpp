@@ -0,0 +1,174 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measures the throughput of the hash functions used for the metadata and by the SMT checker.
+ */
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/IpfsHash.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/SHA256.h>
+#include <libsolutil/SwarmHash.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Reads @a _path if it is a file or all files with the extension ".sol" below it if it is a directory.
+void collectSources(boost::filesystem::path const& _path, vector<string>& o_sources)
+{
+	if (boost::filesystem::is_directory(_path))
+	{
+		for (auto const& entry: boost::filesystem::recursive_directory_iterator(_path))
+			if (boost::filesystem::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+				o_sources.emplace_back(readFileAsString(entry.path()));
+	}
+	else
+		o_sources.emplace_back(readFileAsString(_path));
+}
+
+/// @returns SMT-LIB2 queries of the size and shape of the ones the SMT checker sends to a solver.
+vector<string> smtQueries()
+{
+	vector<string> queries;
+	for (size_t variables = 10; variables <= 2560; variables *= 2)
+	{
+		string query = "(set-option :produce-models true)\n(set-logic ALL)\n";
+		for (size_t i = 0; i < variables; ++i)
+			query += "(declare-fun |x_" + to_string(i) + "_0| () Int)\n";
+		for (size_t i = 1; i < variables; ++i)
+			query +=
+				"(assert (and (>= |x_" + to_string(i) + "_0| 0) (<= |x_" + to_string(i) + "_0| " +
+				"115792089237316195423570985008687907853269984665640564039457584007913129639935) " +
+				"(= |x_" + to_string(i) + "_0| (+ |x_" + to_string(i - 1) + "_0| 1))))\n";
+		query += "(check-sat)\n(get-value (|x_0_0|))\n";
+		queries.emplace_back(move(query));
+	}
+	return queries;
+}
+
+/// Applies @a _hash to every element of @a _inputs @a _repetitions times and prints the throughput.
+void measure(
+	string const& _name,
+	vector<string> const& _inputs,
+	unsigned _repetitions,
+	function<void(string const&)> const& _hash
+)
+{
+	size_t bytes = 0;
+	for (string const& input: _inputs)
+		bytes += input.size();
+
+	auto const start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < _repetitions; ++i)
+		for (string const& input: _inputs)
+			_hash(input);
+	chrono::duration<double> const duration = chrono::steady_clock::now() - start;
+
+	double const megabytes = static_cast<double>(bytes) * _repetitions / (1024.0 * 1024.0);
+	cout << left << setw(24) << _name + ":" << right << fixed << setprecision(2);
+	cout << setw(10) << (duration.count() > 0 ? megabytes / duration.count() : 0.0) << " MB/s";
+	cout << setw(12) << (duration.count() > 0 ? static_cast<double>(_inputs.size()) * _repetitions / duration.count() : 0.0);
+	cout << " hashes/s" << endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(hashbench, measures the throughput of the hash functions.
+Usage: hashbench [Options] [<file or directory>...]
+Hashes the given files and all .sol files in the given directories (e.g. test/libsolidity)
+like the metadata does, hashes generated SMT-LIB2 queries like the SMT checker does
+and prints the number of megabytes hashed per second.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<unsigned>()->default_value(10), "Number of times every input is hashed.")
+		("input-path", po::value<vector<string>>(), "input file or directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<string> sources;
+	if (arguments.count("input-path"))
+		for (string const& path: arguments["input-path"].as<vector<string>>())
+		{
+			if (!boost::filesystem::exists(path))
+			{
+				cerr << "File not found: " << path << endl;
+				return 1;
+			}
+			collectSources(path, sources);
+		}
+
+	unsigned const repetitions = arguments["repetitions"].as<unsigned>();
+	cout << "SHA-256 implementation: " << (sha256UsesHardwareAcceleration() ? "SHA extensions" : "portable") << endl;
+
+	if (!sources.empty())
+	{
+		cout << "Metadata (" << sources.size() << " sources)" << endl;
+		measure("keccak256", sources, repetitions, [](string const& _source) { keccak256(_source); });
+		measure("ipfs", sources, repetitions, [](string const& _source) { ipfsHash(_source); });
+		measure("bzzr1", sources, repetitions, [](string const& _source) { bzzr1Hash(asBytes(_source)); });
+	}
+
+	vector<string> const queries = smtQueries();
+	cout << "SMT queries (" << queries.size() << " queries)" << endl;
+	measure("keccak256", queries, repetitions, [](string const& _query) { keccak256(_query); });
+	measure("sha256", queries, repetitions, [](string const& _query) { sha256(_query); });
+
+	return 0;
+}
@@ -24,18 +24,26 @@
 #include <test/tools/IsolTestOptions.h>
 #include <test/InteractiveTests.h>
 #include <test/EVMHost.h>
+#include <test/libsolidity/SolidityExecutionFramework.h>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
 
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <queue>
 #include <regex>
+#include <sstream>
 #include <utility>
 
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <csignal>
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -130,9 +138,52 @@ private:
 		Quit
 	};
 
+	struct TestFile
+	{
+		fs::path fullPath;
+		string name;
+	};
+
 	void updateTestCase();
 	Request handleResponse(bool _exception);
 
+	/// @returns the test files below @a _path in the order in which they are run.
+	/// Files that are not part of the selected batch are only counted in @a o_skippedCount.
+	static vector<TestFile> collectTestFiles(
+		fs::path const& _basepath,
+		fs::path const& _path,
+		solidity::test::Batcher& _batcher,
+		int& o_skippedCount
+	);
+	/// Runs the test case in @a _file, lets the user handle failures and adds the outcome to @a _stats.
+	static void processTestFile(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		TestFile const& _file,
+		TestStats& _stats
+	);
+#if !defined(_WIN32)
+	/// Runs the test cases in @a _files in worker processes and reports the results in the
+	/// order of @a _files. Test cases that fail are run again by processTestFile().
+	static void processTestFilesConcurrently(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		vector<TestFile> const& _files,
+		TestStats& _stats
+	);
+	/// Runs every @a _stride-th test case in @a _files starting at @a _first and writes the result,
+	/// the compilation cache statistics and the captured output of each of them to the file descriptor
+	/// @a _output. Exits the process when done.
+	[[noreturn]] static void runWorker(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		vector<TestFile> const& _files,
+		size_t _first,
+		size_t _stride,
+		int _output
+	);
+#endif
+
 	TestCreator m_testCaseCreator;
 	TestOptions const& m_options;
 	TestFilter m_filter;
@@ -266,28 +317,25 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCreator _testCaseCreator,
-	TestOptions const& _options,
+vector<TestTool::TestFile> TestTool::collectTestFiles(
 	fs::path const& _basepath,
 	fs::path const& _path,
-	solidity::test::Batcher& _batcher
+	solidity::test::Batcher& _batcher,
+	int& o_skippedCount
 )
 {
+	vector<TestFile> files;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -295,61 +343,231 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
-		{
-			++testCount;
-			paths.pop();
-		}
 		else if (!_batcher.checkAndAdvance())
-		{
-			paths.pop();
-			++skippedCount;
-		}
+			++o_skippedCount;
 		else
-		{
-			++testCount;
-			TestTool testTool(
-				_testCaseCreator,
-				_options,
-				fullpath,
-				currentPath.generic_path().string()
-			);
-			auto result = testTool.process();
+			files.push_back({fullpath, currentPath.generic_path().string()});
+	}
+	return files;
+}
 
-			switch(result)
+void TestTool::processTestFile(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	TestFile const& _file,
+	TestStats& _stats
+)
+{
+	while (true)
+	{
+		++_stats.testCount;
+		TestTool testTool(_testCaseCreator, _options, _file.fullPath, _file.name);
+		auto result = testTool.process();
+
+		if (result == Result::Success)
+			++_stats.successCount;
+		else if (result == Result::Skipped)
+			++_stats.skippedCount;
+		else
+			switch (testTool.handleResponse(result == Result::Exception))
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
-				{
-				case Request::Quit:
-					paths.pop();
-					m_exitRequested = true;
-					break;
-				case Request::Rerun:
-					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
-				case Request::Skip:
-					paths.pop();
-					++skippedCount;
-					break;
-				}
-				break;
-			case Result::Success:
-				paths.pop();
-				++successCount;
+			case Request::Quit:
+				m_exitRequested = true;
 				break;
-			case Result::Skipped:
-				paths.pop();
-				++skippedCount;
+			case Request::Rerun:
+				cout << "Re-running test case..." << endl;
+				--_stats.testCount;
+				continue;
+			case Request::Skip:
+				++_stats.skippedCount;
 				break;
 			}
+		return;
+	}
+}
+
+#if !defined(_WIN32)
+
+namespace
+{
+
+void writeAll(int _fd, void const* _data, size_t _size)
+{
+	auto const* data = static_cast<char const*>(_data);
+	while (_size > 0)
+	{
+		ssize_t written = write(_fd, data, _size);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			_exit(EXIT_FAILURE);
+		data += written;
+		_size -= static_cast<size_t>(written);
+	}
+}
+
+/// @returns false if the end of the input was reached before @a _size bytes were read.
+bool readAll(int _fd, void* _data, size_t _size)
+{
+	auto* data = static_cast<char*>(_data);
+	while (_size > 0)
+	{
+		ssize_t bytesRead = read(_fd, data, _size);
+		if (bytesRead < 0 && errno == EINTR)
+			continue;
+		if (bytesRead <= 0)
+			return false;
+		data += bytesRead;
+		_size -= static_cast<size_t>(bytesRead);
+	}
+	return true;
+}
+
+}
+
+void TestTool::runWorker(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	vector<TestFile> const& _files,
+	size_t _first,
+	size_t _stride,
+	int _output
+)
+{
+	auto& statistics = SolidityExecutionFramework::compilationCacheStatistics();
+	for (size_t index = _first; index < _files.size(); index += _stride)
+	{
+		// The statistics are sent per test case, because the parent process discards
+		// those of the test cases that it runs again.
+		statistics = {};
+		ostringstream output;
+		streambuf* const standardOutput = cout.rdbuf(output.rdbuf());
+		Result result = TestTool(_testCaseCreator, _options, _files[index].fullPath, _files[index].name).process();
+		cout.rdbuf(standardOutput);
+
+		string const text = output.str();
+		uint8_t const resultCode = static_cast<uint8_t>(result);
+		uint64_t const size = text.size();
+		writeAll(_output, &resultCode, sizeof(resultCode));
+		writeAll(_output, &statistics, sizeof(statistics));
+		writeAll(_output, &size, sizeof(size));
+		writeAll(_output, text.data(), text.size());
+	}
+	close(_output);
+	// Skip the destructors of static objects, they belong to the parent process.
+	_exit(EXIT_SUCCESS);
+}
+
+void TestTool::processTestFilesConcurrently(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	vector<TestFile> const& _files,
+	TestStats& _stats
+)
+{
+	// Every worker process runs its test cases with its own compiler state and EVMHost instances.
+	// The results arrive in order, because the i-th test case is run by worker i % workerCount.
+	size_t const workerCount = min(_options.jobs, _files.size());
+	vector<pid_t> workers;
+	vector<int> results;
+	cout.flush();
+	for (size_t worker = 0; worker < workerCount; ++worker)
+	{
+		int fds[2];
+		if (pipe(fds) != 0)
+			BOOST_THROW_EXCEPTION(runtime_error("Could not create a pipe for a worker process."));
+		pid_t pid = fork();
+		if (pid < 0)
+			BOOST_THROW_EXCEPTION(runtime_error("Could not start a worker process."));
+		if (pid == 0)
+		{
+			close(fds[0]);
+			for (int otherResults: results)
+				close(otherResults);
+			runWorker(_testCaseCreator, _options, _files, worker, workerCount, fds[1]);
+		}
+		close(fds[1]);
+		workers.push_back(pid);
+		results.push_back(fds[0]);
+	}
+
+	for (size_t index = 0; index < _files.size(); ++index)
+	{
+		if (m_exitRequested)
+		{
+			++_stats.testCount;
+			continue;
+		}
+
+		int const input = results[index % workerCount];
+		uint8_t resultCode = 0;
+		SolidityExecutionFramework::CompilationCacheStatistics statistics;
+		uint64_t size = 0;
+		string output;
+		bool received =
+			readAll(input, &resultCode, sizeof(resultCode)) &&
+			readAll(input, &statistics, sizeof(statistics)) &&
+			readAll(input, &size, sizeof(size));
+		if (received)
+		{
+			output.resize(size);
+			received = readAll(input, output.data(), output.size());
+		}
+		auto const result = static_cast<Result>(resultCode);
+
+		// Failures are reproduced in this process, which is the one that can interact with the user.
+		// This also covers test cases whose worker process crashed.
+		if (!received || result == Result::Failure || result == Result::Exception)
+			processTestFile(_testCaseCreator, _options, _files[index], _stats);
+		else
+		{
+			cout << output;
+			cout.flush();
+			SolidityExecutionFramework::compilationCacheStatistics() += statistics;
+			++_stats.testCount;
+			if (result == Result::Success)
+				++_stats.successCount;
+			else
+				++_stats.skippedCount;
 		}
 	}
 
-	return { successCount, testCount, skippedCount };
+	for (size_t worker = 0; worker < workerCount; ++worker)
+	{
+		if (m_exitRequested)
+			kill(workers[worker], SIGKILL);
+		close(results[worker]);
+		waitpid(workers[worker], nullptr, 0);
+	}
+}
+
+#endif
+
+TestStats TestTool::processPath(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	solidity::test::Batcher& _batcher
+)
+{
+	TestStats stats;
+	vector<TestFile> const files = collectTestFiles(_basepath, _path, _batcher, stats.skippedCount);
+
+#if !defined(_WIN32)
+	if (_options.jobs > 1 && files.size() > 1 && !m_exitRequested)
+	{
+		processTestFilesConcurrently(_testCaseCreator, _options, files, stats);
+		return stats;
+	}
+#endif
 
+	for (TestFile const& file: files)
+		if (m_exitRequested)
+			++stats.testCount;
+		else
+			processTestFile(_testCaseCreator, _options, file, stats);
+	return stats;
 }
 
 namespace
@@ -495,6 +713,13 @@ int main(int argc, char const *argv[])
 		}
 		cout << "." << endl;
 
+		auto const& compilationStatistics = SolidityExecutionFramework::compilationCacheStatistics();
+		if (compilationStatistics.hits + compilationStatistics.misses > 0)
+			cout <<
+				"Semantic test compilations: " <<
+				compilationStatistics.misses << " (" << fixed << setprecision(1) << compilationStatistics.secondsCompiling << " s), " <<
+				compilationStatistics.hits << " reused (" << compilationStatistics.secondsSaved << " s saved)." << endl;
+
 		if (options.disableSemanticTests)
 			cout << "\nNOTE: Skipped semantics tests.\n" << endl;
 
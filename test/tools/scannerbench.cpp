@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measures the throughput of the Solidity scanner.
+ */
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Reads @a _path if it is a file or all files with the extension ".sol" below it if it is a directory.
+void collectSources(boost::filesystem::path const& _path, vector<string>& o_sources)
+{
+	if (boost::filesystem::is_directory(_path))
+	{
+		for (auto const& entry: boost::filesystem::recursive_directory_iterator(_path))
+			if (boost::filesystem::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+				o_sources.emplace_back(readFileAsString(entry.path()));
+	}
+	else
+		o_sources.emplace_back(readFileAsString(_path));
+}
+
+/// Scans @a _source until the end of input.
+/// @returns the number of tokens.
+size_t scan(string const& _source)
+{
+	CharStream stream(_source, "");
+	Scanner scanner(stream);
+	size_t tokens = 0;
+	for (; scanner.currentToken() != Token::EOS; scanner.next())
+		++tokens;
+	return tokens;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(scannerbench, measures the throughput of the Solidity scanner.
+Usage: scannerbench [Options] <file or directory>...
+Tokenizes the given files and all .sol files in the given directories (e.g. test/libsolidity)
+and prints the number of megabytes scanned per second.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<unsigned>()->default_value(10), "Number of times every source is scanned.")
+		("input-path", po::value<vector<string>>(), "input file or directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-path"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	vector<string> sources;
+	for (string const& path: arguments["input-path"].as<vector<string>>())
+	{
+		if (!boost::filesystem::exists(path))
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+		collectSources(path, sources);
+	}
+
+	size_t bytes = 0;
+	for (string const& source: sources)
+		bytes += source.size();
+
+	unsigned const repetitions = arguments["repetitions"].as<unsigned>();
+	size_t tokens = 0;
+	auto const start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < repetitions; ++i)
+		for (string const& source: sources)
+			tokens += scan(source);
+	chrono::duration<double> const duration = chrono::steady_clock::now() - start;
+
+	double const megabytes = static_cast<double>(bytes) * repetitions / (1024.0 * 1024.0);
+	cout << "Sources:    " << sources.size() << endl;
+	cout << "Size:       " << fixed << setprecision(2) << static_cast<double>(bytes) / (1024.0 * 1024.0) << " MB" << endl;
+	cout << "Tokens:     " << tokens / max(repetitions, 1u) << endl;
+	cout << "Time:       " << duration.count() << " s for " << repetitions << " repetitions" << endl;
+	cout << "Throughput: " << (duration.count() > 0 ? megabytes / duration.count() : 0.0) << " MB/s" << endl;
+
+	return 0;
+}
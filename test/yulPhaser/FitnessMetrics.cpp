@@ -277,6 +277,39 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricMinimum_evaluate_should_compute_minimum_of_
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(ParallelFitnessMetricTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_values_of_the_wrapped_metric_in_order, FitnessMetricCombinationFixture)
+{
+	vector<Chromosome> chromosomes = {
+		m_chromosome,
+		Chromosome("a"),
+		Chromosome("LT"),
+		Chromosome(""),
+		Chromosome("Iu"),
+		Chromosome("IuO"),
+		m_chromosome,
+	};
+	vector<size_t> expectedValues;
+	for (Chromosome const& chromosome: chromosomes)
+		expectedValues.push_back(m_simpleMetrics[1]->evaluate(chromosome));
+
+	auto cachedMetric = make_shared<ProgramSize>(nullopt, m_programCache, m_weights, 2);
+#ifdef _WIN32
+	size_t const workerCount = 1;
+#else
+	size_t const workerCount = 3;
+#endif
+	ParallelFitnessMetric metric(cachedMetric, workerCount, {m_programCache});
+
+	BOOST_TEST(metric.evaluateAll(chromosomes) == expectedValues);
+	m_programCache->startRound(1);
+	BOOST_TEST(metric.evaluateAll(chromosomes) == expectedValues);
+	BOOST_TEST(metric.evaluateAll({chromosomes[2]}) == vector<size_t>{expectedValues[2]});
+	BOOST_TEST(metric.evaluate(chromosomes[3]) == expectedValues[3]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
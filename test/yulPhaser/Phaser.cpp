@@ -89,6 +89,7 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* jobs = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -277,6 +278,19 @@ BOOST_FIXTURE_TEST_CASE(build_should_pass_program_caches_to_metrics, FitnessMetr
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_wrap_metric_for_parallel_evaluation_if_multiple_jobs_requested, FitnessMetricFactoryFixture)
+{
+	m_options.metricAggregator = MetricAggregatorChoice::Maximum;
+	m_options.jobs = 3;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto parallelMetric = dynamic_cast<ParallelFitnessMetric*>(metric.get());
+	BOOST_REQUIRE(parallelMetric != nullptr);
+	BOOST_TEST(parallelMetric->workerCount() == 3);
+	BOOST_TEST(dynamic_cast<FitnessMetricMaximum const*>(&parallelMetric->metric()) != nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(PopulationFactoryTest)
 
@@ -387,7 +401,7 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxTotalCodeSize = */ 100};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -396,12 +410,13 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 	{
 		BOOST_REQUIRE(caches[i] != nullptr);
 		BOOST_TEST(toString(caches[i]->program()) == toString(m_programs[i]));
+		BOOST_CHECK(caches[i]->maxTotalCodeSize() == options.maxTotalCodeSize);
 	}
 }
 
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false, /* maxTotalCodeSize = */ nullopt};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -213,6 +213,53 @@ BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds,
 	BOOST_TEST(m_programCache.size() == 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(startRound_should_keep_entries_while_within_size_limit, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	ProgramCache cache(m_program, sizeI + sizeIu + sizeL);
+
+	cache.optimiseProgram("L");
+	cache.optimiseProgram("Iu");
+	cache.startRound(1);
+	cache.startRound(2);
+	cache.startRound(3);
+
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"L", "I", "Iu"}));
+	BOOST_TEST(cache.gatherStats().totalCodeSize == sizeI + sizeIu + sizeL);
+}
+
+BOOST_FIXTURE_TEST_CASE(startRound_should_remove_least_recently_used_entries_if_size_limit_exceeded, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	ProgramCache cache(m_program, sizeI + sizeIu);
+
+	cache.optimiseProgram("L");
+	cache.startRound(1);
+	cache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"L", "I", "Iu"}));
+
+	cache.startRound(2);
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"I", "Iu"}));
+	BOOST_TEST(cache.gatherStats().totalCodeSize == sizeI + sizeIu);
+}
+
+BOOST_FIXTURE_TEST_CASE(startRound_should_remove_longer_entries_before_their_prefixes, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	ProgramCache cache(m_program, sizeI);
+
+	cache.optimiseProgram("IuO");
+	cache.startRound(1);
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"I"}));
+	BOOST_TEST(cache.gatherStats().totalCodeSize == sizeI);
+
+	BOOST_TEST(toString(cache.optimiseProgram("IuO")) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(cache.gatherStats().hits == 1);
+}
+
 BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCacheFixture)
 {
 	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
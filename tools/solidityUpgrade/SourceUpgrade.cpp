@@ -26,6 +26,8 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 #ifdef _WIN32 // windows
 	#include <io.h>
 	#define isatty _isatty
@@ -278,9 +280,7 @@ void SourceUpgrade::tryCompile() const
 	{
 		if (m_compiler->parse())
 		{
-			if (m_compiler->analyze())
-				m_compiler->compile();
-			else
+			if (!m_compiler->analyze())
 				if (verbose)
 				{
 					error() <<
@@ -318,80 +318,161 @@ void SourceUpgrade::tryCompile() const
 
 void SourceUpgrade::runUpgrade()
 {
-	bool recompile = true;
+	updateSourceInfo();
 
-	while (recompile && !m_compiler->errors().empty())
+	vector<string> sourceNames = m_compiler->sourceNames();
+	set<string> sourcesToUpgrade(sourceNames.begin(), sourceNames.end());
+
+	while (!sourcesToUpgrade.empty() && !m_compiler->errors().empty())
 	{
-		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
+		m_suite.reset();
 
-		if (recompile)
-		{
-			m_suite.reset();
-			resetCompiler();
-			tryCompile();
-		}
+		set<string> upgradedSources;
+		for (string const& sourceName: sourcesToUpgrade)
+			if (analyzeAndUpgrade(sourceName))
+				upgradedSources.insert(sourceName);
+
+		if (upgradedSources.empty())
+			break;
+
+		// Analysis is not modular, so sources importing an upgraded source have to be
+		// analysed again as well. All other sources are unaffected by this pass.
+		sourcesToUpgrade = withImporters(move(upgradedSources));
+		for (string const& sourceName: sourcesToUpgrade)
+			m_pendingChanges.erase(sourceName);
+
+		resetCompiler(withImports(sourcesToUpgrade));
+		tryCompile();
+		updateSourceInfo();
 	}
 }
 
-bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
+bool SourceUpgrade::analyzeAndUpgrade(string const& _sourceName)
 {
 	bool applyUnsafe = m_args.count(g_argUnsafe);
 	bool verbose = m_args.count(g_argVerbose);
 
 	if (verbose)
-		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
+		log() << "Analyzing and upgrading " << _sourceName << "." << endl;
 
+	size_t firstChange = m_suite.changes().size();
 	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
-		m_suite.analyze(*m_compiler, m_compiler->ast(_sourceCode.first));
+		m_suite.analyze(*m_compiler, m_compiler->ast(_sourceName));
 
-	if (!m_suite.changes().empty())
+	vector<UpgradeChange const*> changes;
+	for (size_t i = firstChange; i < m_suite.changes().size(); ++i)
 	{
-		auto& change = m_suite.changes().front();
+		UpgradeChange const& change = m_suite.changes()[i];
 
 		if (verbose)
 			change.log(*m_compiler, true);
 
-		if (change.level() == UpgradeChange::Level::Safe)
-		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
-		{
-			if (applyUnsafe)
-			{
-				applyChange(_sourceCode, change);
-				return true;
-			}
-		}
+		if (change.level() == UpgradeChange::Level::Safe || applyUnsafe)
+			changes.push_back(&change);
 	}
 
-	return false;
+	// Changes are applied back to front, so that the locations of the remaining
+	// changes stay valid. Changes overlapping a change already selected are
+	// skipped and found again in the next pass.
+	stable_sort(changes.begin(), changes.end(), [](UpgradeChange const* _a, UpgradeChange const* _b) {
+		return _a->location().start > _b->location().start;
+	});
+	vector<UpgradeChange const*> nonOverlappingChanges;
+	for (UpgradeChange const* change: changes)
+		if (
+			nonOverlappingChanges.empty() || (
+				change->location().start < nonOverlappingChanges.back()->location().start &&
+				change->location().end <= nonOverlappingChanges.back()->location().start
+			)
+		)
+			nonOverlappingChanges.push_back(change);
+
+	m_pendingChanges[_sourceName] = m_suite.changes().size() - firstChange - nonOverlappingChanges.size();
+
+	if (nonOverlappingChanges.empty())
+		return false;
+
+	applyChanges(_sourceName, nonOverlappingChanges);
+	return true;
 }
 
-void SourceUpgrade::applyChange(
-	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
+void SourceUpgrade::applyChanges(
+	string const& _sourceName,
+	vector<UpgradeChange const*> const& _changes
 )
 {
 	bool dryRun = m_args.count(g_argDryRun);
 	bool verbose = m_args.count(g_argVerbose);
 
-	if (verbose)
+	string& sourceCode = m_sourceCodes[_sourceName];
+	for (UpgradeChange const* change: _changes)
 	{
-		log() << "Applying change to " << _sourceCode.first << endl << endl;
-		log() << _change.patch();
-	}
+		if (verbose)
+		{
+			log() << "Applying change to " << _sourceName << endl << endl;
+			log() << change->patch();
+		}
 
-	m_sourceCodes[_sourceCode.first] = _change.apply(_sourceCode.second);
+		sourceCode = change->apply(move(sourceCode));
+	}
 
 	if (!dryRun)
-		writeInputFile(_sourceCode.first, m_sourceCodes[_sourceCode.first]);
+		writeInputFile(_sourceName, sourceCode);
+}
+
+void SourceUpgrade::updateSourceInfo()
+{
+	m_errorCounts[""] = 0;
+	for (string const& sourceName: m_compiler->sourceNames())
+	{
+		m_errorCounts[sourceName] = 0;
+
+		set<string>& imports = m_imports[sourceName];
+		imports.clear();
+		if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
+			for (auto const* import: ASTNode::filteredNodes<ImportDirective>(m_compiler->ast(sourceName).nodes()))
+				imports.insert(*import->annotation().absolutePath);
+	}
+
+	for (auto const& error: m_compiler->errors())
+	{
+		SourceLocation const* location = error->sourceLocation();
+		++m_errorCounts[location && location->sourceName ? *location->sourceName : ""];
+	}
+}
+
+set<string> SourceUpgrade::withImporters(set<string> _sourceNames) const
+{
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto const& [sourceName, imports]: m_imports)
+			if (!_sourceNames.count(sourceName))
+				for (string const& import: imports)
+					if (_sourceNames.count(import))
+					{
+						_sourceNames.insert(sourceName);
+						changed = true;
+						break;
+					}
+	}
+	return _sourceNames;
+}
+
+set<string> SourceUpgrade::withImports(set<string> _sourceNames) const
+{
+	vector<string> toVisit(_sourceNames.begin(), _sourceNames.end());
+	while (!toVisit.empty())
+	{
+		string sourceName = move(toVisit.back());
+		toVisit.pop_back();
+		if (m_imports.count(sourceName))
+			for (string const& import: m_imports.at(sourceName))
+				if (_sourceNames.insert(import).second)
+					toVisit.push_back(import);
+	}
+	return _sourceNames;
 }
 
 void SourceUpgrade::printErrors() const
@@ -409,8 +490,14 @@ void SourceUpgrade::printStatistics() const
 	out() << endl;
 	out() << "After upgrade:" << endl;
 	out() << endl;
-	error() << "Found " << m_compiler->errors().size() << " errors." << endl;
-	success() << "Found " << m_suite.changes().size() << " upgrades." << endl;
+	size_t errorCount = 0;
+	for (auto const& [sourceName, count]: m_errorCounts)
+		errorCount += count;
+	size_t changeCount = 0;
+	for (auto const& [sourceName, count]: m_pendingChanges)
+		changeCount += count;
+	error() << "Found " << errorCount << " errors." << endl;
+	success() << "Found " << changeCount << " upgrades." << endl;
 }
 
 bool SourceUpgrade::readInputFiles()
@@ -524,10 +611,15 @@ ReadCallback::Callback SourceUpgrade::fileReader()
 	return fileReader;
 }
 
-void SourceUpgrade::resetCompiler()
+void SourceUpgrade::resetCompiler(set<string> const& _sourceNames)
 {
+	StringMap sources;
+	for (string const& sourceName: _sourceNames)
+		if (m_sourceCodes.count(sourceName))
+			sources[sourceName] = m_sourceCodes.at(sourceName);
+
 	m_compiler->reset();
-	m_compiler->setSources(m_sourceCodes);
+	m_compiler->setSources(move(sources));
 	m_compiler->setParserErrorRecovery(true);
 }
 
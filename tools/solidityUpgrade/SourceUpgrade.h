@@ -30,6 +30,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include <memory>
+#include <set>
 
 namespace solidity::tools
 {
@@ -115,28 +116,39 @@ private:
 		};
 	};
 
-	/// Parses the current sources and runs analyses as well as compilation on
-	/// them if parsing was successful.
+	/// Parses the current sources and runs analyses on them. Code generation
+	/// is not needed to find upgrades and is skipped.
 	void tryCompile() const;
-	/// Analyses and upgrades the sources given. The upgrade happens in a loop,
-	/// applying one change at a time, which is run until no applicable changes
-	/// are found any more. Only one change is done at a time and all sources
-	/// are being compiled again after each change.
+	/// Analyses and upgrades the sources given. The upgrade happens in passes,
+	/// which are run until no applicable changes are found any more. Each pass
+	/// applies all non-overlapping changes to every analysed source. Only the
+	/// sources that were changed and the sources importing them are analysed
+	/// and upgraded again in the next pass; they are compiled together with
+	/// their imports.
 	void runUpgrade();
-	/// Runs upgrade analysis on source and applies upgrades changes to it.
-	/// Returns `true` if there're still changes that can be applied,
-	/// `false` otherwise.
-	bool analyzeAndUpgrade(
-		std::pair<std::string, std::string> const& _sourceCode
+	/// Runs upgrade analysis on the source given and applies all changes found
+	/// that do not overlap. Unsafe changes are only applied if `--unsafe` was
+	/// passed. Changes skipped due to an overlap are found again in the next pass.
+	/// Returns `true` if the source code was changed, `false` otherwise.
+	bool analyzeAndUpgrade(std::string const& _sourceName);
+
+	/// Applies the changes given, which have to be sorted by descending start
+	/// position and must not overlap, to the source code of @a _sourceName.
+	/// If no `--dry-run` was passed via the commandline, the upgraded source
+	/// code is written back to its file.
+	void applyChanges(
+		std::string const& _sourceName,
+		std::vector<UpgradeChange const*> const& _changes
 	);
 
-	/// Applies the change given to its source code. If no `--dry-run` was
-	/// passed via the commandline, the upgraded source code is written back
-	/// to its file.
-	void applyChange(
-		std::pair<std::string, std::string> const& _sourceCode,
-		UpgradeChange& _change
-	);
+	/// Records imports and number of errors of all sources that were compiled last.
+	void updateSourceInfo();
+	/// @returns the sources given and all sources that import one of them, directly
+	/// or indirectly.
+	std::set<std::string> withImporters(std::set<std::string> _sourceNames) const;
+	/// @returns the sources given and all sources imported by one of them, directly
+	/// or indirectly.
+	std::set<std::string> withImports(std::set<std::string> _sourceNames) const;
 
 	/// Prints all errors (excluding warnings) the compiler currently reported.
 	void printErrors() const;
@@ -151,9 +163,9 @@ private:
 	/// Returns a file reader function that fills `m_sources`.
 	frontend::ReadCallback::Callback fileReader();
 
-	/// Resets the compiler stack and configures sources to compile.
+	/// Resets the compiler stack and configures the sources given to compile.
 	/// Also enables error recovery.
-	void resetCompiler();
+	void resetCompiler(std::set<std::string> const& _sourceNames);
 	/// Resets the compiler stack and configures sources to compile.
 	/// Also enables error recovery. Passes read callback to the compiler stack.
 	void resetCompiler(frontend::ReadCallback::Callback const& _callback);
@@ -168,6 +180,13 @@ private:
 	std::vector<boost::filesystem::path> m_allowedDirectories;
 	/// Holds all upgrade modules and source upgrades.
 	Suite m_suite;
+	/// Sources directly imported by each source, as of its last compilation.
+	std::map<std::string, std::set<std::string>> m_imports;
+	/// Number of errors reported for each source in its last compilation.
+	/// Errors without source location are stored under the empty name.
+	std::map<std::string, size_t> m_errorCounts;
+	/// Number of changes found in each source by its last analysis that were not applied.
+	std::map<std::string, size_t> m_pendingChanges;
 };
 
 }
@@ -32,4 +32,6 @@ struct FileOpenError: virtual util::Exception {};
 struct FileReadError: virtual util::Exception {};
 struct FileWriteError: virtual util::Exception {};
 
+struct WorkerProcessError: virtual util::Exception {};
+
 }
@@ -18,15 +18,83 @@
 
 #include <tools/yulPhaser/FitnessMetrics.h>
 
+#include <tools/yulPhaser/Exceptions.h>
+
 #include <libsolutil/CommonIO.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+namespace
+{
+
+#ifndef _WIN32
+bool writeAll(int _fd, void const* _data, size_t _size)
+{
+	auto const* data = static_cast<char const*>(_data);
+	while (_size > 0)
+	{
+		ssize_t written = write(_fd, data, _size);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return false;
+		data += written;
+		_size -= static_cast<size_t>(written);
+	}
+	return true;
+}
+
+bool readAll(int _fd, void* _data, size_t _size)
+{
+	auto* data = static_cast<char*>(_data);
+	while (_size > 0)
+	{
+		ssize_t received = read(_fd, data, _size);
+		if (received < 0 && errno == EINTR)
+			continue;
+		if (received <= 0)
+			return false;
+		data += received;
+		_size -= static_cast<size_t>(received);
+	}
+	return true;
+}
+
+void appendNumber(string& _buffer, uint64_t _value)
+{
+	_buffer.append(reinterpret_cast<char const*>(&_value), sizeof(_value));
+}
+#endif
+
+}
+
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> values;
+	values.reserve(_chromosomes.size());
+	for (Chromosome const& chromosome: _chromosomes)
+		values.push_back(evaluate(chromosome));
+
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -118,3 +186,173 @@ size_t FitnessMetricMinimum::evaluate(Chromosome const& _chromosome)
 
 	return minimum;
 }
+
+ParallelFitnessMetric::~ParallelFitnessMetric()
+{
+	stopWorkers();
+}
+
+size_t ParallelFitnessMetric::evaluate(Chromosome const& _chromosome)
+{
+	return m_metric->evaluate(_chromosome);
+}
+
+vector<size_t> ParallelFitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	if (m_workerCount == 1 || _chromosomes.size() <= 1)
+		return m_metric->evaluateAll(_chromosomes);
+
+#ifdef _WIN32
+	assertThrow(false, BadInput, "Parallel fitness evaluation is not supported on Windows.");
+#else
+	if (m_workers.empty())
+		startWorkers();
+
+	// Sorting puts chromosomes with common prefixes next to each other so that contiguous ranges
+	// can be evaluated by the same worker, reusing the programs in its cache.
+	vector<size_t> order(_chromosomes.size());
+	iota(order.begin(), order.end(), 0);
+	sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+		return _chromosomes[_a].genes() < _chromosomes[_b].genes();
+	});
+
+	size_t const workerCount = min(m_workers.size(), _chromosomes.size());
+	auto rangeStart = [&](size_t _worker) { return _chromosomes.size() * _worker / workerCount; };
+
+	// Every worker reads its whole request before replying so all requests can be sent first.
+	for (size_t worker = 0; worker < workerCount; ++worker)
+	{
+		string request;
+		appendNumber(request, rangeStart(worker + 1) - rangeStart(worker));
+		for (auto const& cache: m_programCaches)
+			appendNumber(request, cache != nullptr ? cache->currentRound() : 0);
+		for (size_t i = rangeStart(worker); i < rangeStart(worker + 1); ++i)
+		{
+			string const& genes = _chromosomes[order[i]].genes();
+			appendNumber(request, genes.size());
+			request += genes;
+		}
+		assertThrow(
+			writeAll(m_workers[worker].requestPipe, request.data(), request.size()),
+			WorkerProcessError,
+			"Could not send chromosomes to a worker process."
+		);
+	}
+
+	vector<size_t> values(_chromosomes.size());
+	for (size_t worker = 0; worker < workerCount; ++worker)
+	{
+		vector<uint64_t> results(rangeStart(worker + 1) - rangeStart(worker));
+		assertThrow(
+			readAll(m_workers[worker].resultPipe, results.data(), results.size() * sizeof(uint64_t)),
+			WorkerProcessError,
+			"Fitness evaluation in a worker process failed."
+		);
+		for (size_t i = 0; i < results.size(); ++i)
+			values[order[rangeStart(worker) + i]] = static_cast<size_t>(results[i]);
+	}
+
+	return values;
+#endif
+}
+
+void ParallelFitnessMetric::startWorkers()
+{
+#ifndef _WIN32
+	// A worker that died must result in an error rather than terminate the process.
+	signal(SIGPIPE, SIG_IGN);
+	// Otherwise buffered output would be written again by every worker.
+	cout.flush();
+	cerr.flush();
+
+	for (size_t i = 0; i < m_workerCount; ++i)
+	{
+		int requestPipe[2];
+		int resultPipe[2];
+		assertThrow(pipe(requestPipe) == 0, WorkerProcessError, "Could not create a pipe.");
+		assertThrow(pipe(resultPipe) == 0, WorkerProcessError, "Could not create a pipe.");
+
+		pid_t processID = fork();
+		assertThrow(processID >= 0, WorkerProcessError, "Could not start a worker process.");
+		if (processID == 0)
+		{
+			// Otherwise the workers started earlier would not see their requests pipes being closed.
+			for (Worker const& worker: m_workers)
+			{
+				close(worker.requestPipe);
+				close(worker.resultPipe);
+			}
+			close(requestPipe[1]);
+			close(resultPipe[0]);
+			runWorker(requestPipe[0], resultPipe[1]);
+		}
+
+		close(requestPipe[0]);
+		close(resultPipe[1]);
+		m_workers.push_back({processID, requestPipe[1], resultPipe[0]});
+	}
+#endif
+}
+
+void ParallelFitnessMetric::stopWorkers()
+{
+#ifndef _WIN32
+	for (Worker const& worker: m_workers)
+	{
+		close(worker.requestPipe);
+		close(worker.resultPipe);
+	}
+	for (Worker const& worker: m_workers)
+		waitpid(worker.processID, nullptr, 0);
+	m_workers.clear();
+#endif
+}
+
+void ParallelFitnessMetric::runWorker(int _requestPipe, int _resultPipe)
+{
+#ifndef _WIN32
+	int exitCode = 0;
+	try
+	{
+		uint64_t chromosomeCount = 0;
+		while (readAll(_requestPipe, &chromosomeCount, sizeof(chromosomeCount)))
+		{
+			vector<uint64_t> roundNumbers(m_programCaches.size());
+			if (!readAll(_requestPipe, roundNumbers.data(), roundNumbers.size() * sizeof(uint64_t)))
+				break;
+			for (size_t i = 0; i < m_programCaches.size(); ++i)
+				if (m_programCaches[i] != nullptr && roundNumbers[i] > m_programCaches[i]->currentRound())
+					m_programCaches[i]->startRound(static_cast<size_t>(roundNumbers[i]));
+
+			vector<Chromosome> chromosomes;
+			for (uint64_t i = 0; i < chromosomeCount; ++i)
+			{
+				uint64_t length = 0;
+				if (!readAll(_requestPipe, &length, sizeof(length)))
+					break;
+				string genes(static_cast<size_t>(length), '\0');
+				if (!readAll(_requestPipe, genes.data(), genes.size()))
+					break;
+				chromosomes.emplace_back(move(genes));
+			}
+			if (chromosomes.size() != chromosomeCount)
+				break;
+
+			vector<uint64_t> results;
+			for (size_t value: m_metric->evaluateAll(chromosomes))
+				results.push_back(value);
+			if (!writeAll(_resultPipe, results.data(), results.size() * sizeof(uint64_t)))
+				break;
+		}
+	}
+	catch (...)
+	{
+		exitCode = EXIT_FAILURE;
+	}
+	// Skip the destructors of the state shared with the parent process.
+	_exit(exitCode);
+#else
+	(void)_requestPipe;
+	(void)_resultPipe;
+#endif
+}
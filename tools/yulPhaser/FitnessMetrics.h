@@ -28,7 +28,9 @@
 #include <libyul/optimiser/Metrics.h>
 
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -49,6 +51,9 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+	/// Evaluates a batch of chromosomes. The default implementation calls @a evaluate() for each of them.
+	/// @returns fitness values in the same order as the chromosomes.
+	virtual std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
 };
 
 /**
@@ -188,4 +193,59 @@ public:
 	size_t evaluate(Chromosome const& _chromosome) override;
 };
 
+/**
+ * Fitness metric that evaluates batches of chromosomes with another metric in a pool of worker
+ * processes and returns the same values the other metric would.
+ *
+ * The workers are started when the first batch with more than one chromosome is evaluated.
+ * Each of them is a copy of the current process and has its own copy of the program caches used by
+ * the metric. The chromosomes of a batch are sorted and split into contiguous ranges, one per
+ * worker, so that chromosomes sharing a prefix tend to end up in the same cache. The round numbers
+ * of the caches passed to the constructor are forwarded to the copies of the workers with every batch.
+ *
+ * Processes are used instead of threads because the optimiser relies on global state
+ * (e.g. the YulString repository) that is not thread-safe. Not supported on Windows.
+ */
+class ParallelFitnessMetric: public FitnessMetric
+{
+public:
+	explicit ParallelFitnessMetric(
+		std::shared_ptr<FitnessMetric> _metric,
+		size_t _workerCount,
+		std::vector<std::shared_ptr<ProgramCache>> _programCaches = {}
+	):
+		m_metric(std::move(_metric)),
+		m_workerCount(_workerCount),
+		m_programCaches(std::move(_programCaches))
+	{
+		assert(m_metric != nullptr);
+		assert(m_workerCount > 0);
+	}
+	~ParallelFitnessMetric() override;
+
+	FitnessMetric const& metric() const { return *m_metric; }
+	size_t workerCount() const { return m_workerCount; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes) override;
+
+private:
+	struct Worker
+	{
+		int processID;
+		int requestPipe;
+		int resultPipe;
+	};
+
+	void startWorkers();
+	void stopWorkers();
+	/// Evaluates batches received from @a _requestPipe until it is closed.
+	void runWorker(int _requestPipe, int _resultPipe);
+
+	std::shared_ptr<FitnessMetric> m_metric;
+	size_t m_workerCount;
+	std::vector<std::shared_ptr<ProgramCache>> m_programCaches;
+	std::vector<Worker> m_workers;
+};
+
 }
@@ -219,6 +219,7 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["jobs"].as<size_t>(),
 	};
 }
 
@@ -231,7 +232,9 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 {
 	assert(_programCaches.size() == _programs.size());
 	assert(_programs.size() > 0 && "Validations should prevent this from being executed with zero files.");
+	assert(_options.jobs > 0);
 
+	vector<shared_ptr<ProgramCache>> const programCaches = _programCaches;
 	vector<shared_ptr<FitnessMetric>> metrics;
 	switch (_options.metric)
 	{
@@ -263,19 +266,29 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	unique_ptr<FitnessMetric> aggregatedMetric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+
+	if (_options.jobs == 1)
+		return aggregatedMetric;
+
+	return make_unique<ParallelFitnessMetric>(move(aggregatedMetric), _options.jobs, programCaches);
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -358,6 +371,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("program-cache-size-limit") > 0 ?
+			static_cast<optional<size_t>>(_arguments["program-cache-size-limit"].as<size_t>()) :
+			nullopt,
 	};
 }
 
@@ -368,7 +384,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(move(program), _options.maxTotalCodeSize) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -458,6 +478,12 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			"or removed using this option. The value given here is applied after it."
 		)
 		("seed", po::value<uint32_t>()->value_name("<NUM>"), "Seed for the random number generator.")
+		(
+			"jobs",
+			po::value<size_t>()->value_name("<NUM>")->default_value(1),
+			"Number of worker processes used to evaluate the fitness of chromosomes. "
+			"Each worker keeps its own program cache. Not supported on Windows."
+		)
 		(
 			"rounds",
 			po::value<size_t>()->value_name("<NUM>"),
@@ -711,8 +737,16 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default but highly recommended if your computer has enough RAM. "
+			"Use --program-cache-size-limit to put an upper limit on memory usage."
+		)
+		(
+			"program-cache-size-limit",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Maximum total size of the programs stored in each cache, measured in AST nodes. "
+			"With a limit, cached programs are kept across rounds and the least recently used ones "
+			"are removed at the beginning of a round once the limit is exceeded. "
+			"(default=keep only programs used in the current and the previous round)"
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -811,6 +845,16 @@ void Phaser::runPhaser(po::variables_map const& _arguments)
 	auto metricOptions = FitnessMetricFactory::Options::fromCommandLine(_arguments);
 	auto populationOptions = PopulationFactory::Options::fromCommandLine(_arguments);
 
+	assertThrow(metricOptions.jobs > 0, BadInput, "The number of jobs must be at least 1.");
+#ifdef _WIN32
+	assertThrow(metricOptions.jobs == 1, BadInput, "Parallel fitness evaluation is not supported on Windows.");
+#endif
+	assertThrow(
+		metricOptions.jobs == 1 || !_arguments["show-cache-stats"].as<bool>(),
+		BadInput,
+		"Cache statistics are not available with more than one job because the caches are kept in the worker processes."
+	);
+
 	vector<Program> programs = ProgramFactory::build(programOptions);
 	vector<shared_ptr<ProgramCache>> programCaches = ProgramCacheFactory::build(cacheOptions, programs);
 	CodeWeights codeWeights = CodeWeightFactory::buildFromCommandLine(_arguments);
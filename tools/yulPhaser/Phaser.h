@@ -158,6 +158,7 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		size_t jobs;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -216,6 +217,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> maxTotalCodeSize;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
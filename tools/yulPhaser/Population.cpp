@@ -96,26 +96,23 @@ Population Population::select(Selection const& _selection) const
 
 Population Population::mutate(Selection const& _selection, function<Mutation> _mutation) const
 {
-	vector<Individual> mutatedIndividuals;
+	vector<Chromosome> mutatedChromosomes;
 	for (size_t i: _selection.materialise(m_individuals.size()))
-		mutatedIndividuals.emplace_back(_mutation(m_individuals[i].chromosome), *m_fitnessMetric);
+		mutatedChromosomes.push_back(_mutation(m_individuals[i].chromosome));
 
-	return Population(m_fitnessMetric, mutatedIndividuals);
+	return Population(m_fitnessMetric, move(mutatedChromosomes));
 }
 
 Population Population::crossover(PairSelection const& _selection, function<Crossover> _crossover) const
 {
-	vector<Individual> crossedIndividuals;
+	vector<Chromosome> crossedChromosomes;
 	for (auto const& [i, j]: _selection.materialise(m_individuals.size()))
-	{
-		auto childChromosome = _crossover(
+		crossedChromosomes.push_back(_crossover(
 			m_individuals[i].chromosome,
 			m_individuals[j].chromosome
-		);
-		crossedIndividuals.emplace_back(move(childChromosome), *m_fitnessMetric);
-	}
+		));
 
-	return Population(m_fitnessMetric, crossedIndividuals);
+	return Population(m_fitnessMetric, move(crossedChromosomes));
 }
 
 tuple<Population, Population> Population::symmetricCrossoverWithRemainder(
@@ -125,15 +122,15 @@ tuple<Population, Population> Population::symmetricCrossoverWithRemainder(
 {
 	vector<int> indexSelected(m_individuals.size(), false);
 
-	vector<Individual> crossedIndividuals;
+	vector<Chromosome> crossedChromosomes;
 	for (auto const& [i, j]: _selection.materialise(m_individuals.size()))
 	{
 		auto children = _symmetricCrossover(
 			m_individuals[i].chromosome,
 			m_individuals[j].chromosome
 		);
-		crossedIndividuals.emplace_back(move(get<0>(children)), *m_fitnessMetric);
-		crossedIndividuals.emplace_back(move(get<1>(children)), *m_fitnessMetric);
+		crossedChromosomes.push_back(move(get<0>(children)));
+		crossedChromosomes.push_back(move(get<1>(children)));
 		indexSelected[i] = true;
 		indexSelected[j] = true;
 	}
@@ -144,7 +141,7 @@ tuple<Population, Population> Population::symmetricCrossoverWithRemainder(
 			remainder.emplace_back(m_individuals[i]);
 
 	return {
-		Population(m_fitnessMetric, crossedIndividuals),
+		Population(m_fitnessMetric, move(crossedChromosomes)),
 		Population(m_fitnessMetric, remainder),
 	};
 }
@@ -191,9 +188,13 @@ vector<Individual> Population::chromosomesToIndividuals(
 	vector<Chromosome> _chromosomes
 )
 {
+	// Evaluating all chromosomes at once lets the metric process them in parallel.
+	vector<size_t> fitness = _fitnessMetric.evaluateAll(_chromosomes);
+	assert(fitness.size() == _chromosomes.size());
+
 	vector<Individual> individuals;
-	for (auto& chromosome: _chromosomes)
-		individuals.emplace_back(move(chromosome), _fitnessMetric);
+	for (size_t i = 0; i < _chromosomes.size(); ++i)
+		individuals.emplace_back(move(_chromosomes[i]), fitness[i]);
 
 	return individuals;
 }
@@ -22,6 +22,10 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 using namespace std;
 using namespace solidity::yul;
 using namespace solidity::phaser;
@@ -84,7 +88,9 @@ Program ProgramCache::optimiseProgram(
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		size_t codeSize = intermediateProgram.codeSize(CacheStats::StorageWeights);
+		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound, codeSize}});
+		m_totalCodeSize += codeSize;
 		++m_misses;
 	}
 
@@ -96,12 +102,21 @@ void ProgramCache::startRound(size_t _roundNumber)
 	assert(_roundNumber > m_currentRound);
 	m_currentRound = _roundNumber;
 
+	if (m_maxTotalCodeSize.has_value())
+	{
+		enforceSizeLimit();
+		return;
+	}
+
 	for (auto pair = m_entries.begin(); pair != m_entries.end();)
 	{
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
+		{
+			m_totalCodeSize -= pair->second.codeSize;
 			m_entries.erase(pair++);
+		}
 		else
 			++pair;
 	}
@@ -110,9 +125,39 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
+void ProgramCache::enforceSizeLimit()
+{
+	assert(m_maxTotalCodeSize.has_value());
+	if (m_totalCodeSize <= m_maxTotalCodeSize.value())
+		return;
+
+	vector<map<string, CacheEntry>::iterator> entries;
+	for (auto pair = m_entries.begin(); pair != m_entries.end(); ++pair)
+		entries.push_back(pair);
+
+	// Using an entry updates the round number of all its prefixes too, so a prefix is never
+	// older than the entries it is a prefix of. Removing longer entries first among the ones
+	// last used in the same round ensures that optimiseProgram() can still find all cached prefixes.
+	sort(entries.begin(), entries.end(), [](auto const& _a, auto const& _b) {
+		return
+			make_tuple(_a->second.roundNumber, _b->first.size()) <
+			make_tuple(_b->second.roundNumber, _a->first.size());
+	});
+
+	for (auto const& pair: entries)
+	{
+		if (m_totalCodeSize <= m_maxTotalCodeSize.value())
+			break;
+
+		m_totalCodeSize -= pair->second.codeSize;
+		m_entries.erase(pair);
+	}
+}
+
 Program const* ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
 {
 	auto const& pair = m_entries.find(_abbreviatedOptimisationSteps);
@@ -127,20 +172,11 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
-{
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
-
-	return size;
-}
-
 map<size_t, size_t> ProgramCache::countRoundEntries() const
 {
 	map<size_t, size_t> counts;
@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <map>
+#include <optional>
 #include <string>
 
 namespace solidity::phaser
@@ -37,10 +38,13 @@ struct CacheEntry
 {
 	Program program;
 	size_t roundNumber;
+	/// Size of the program measured with @a CacheStats::StorageWeights.
+	size_t codeSize;
 
-	CacheEntry(Program _program, size_t _roundNumber):
+	CacheEntry(Program _program, size_t _roundNumber, size_t _codeSize):
 		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
+		roundNumber(_roundNumber),
+		codeSize(_codeSize) {}
 };
 
 /**
@@ -89,25 +93,28 @@ struct CacheStats
  *
  * The cache keeps track of the current round number and associates newly created entries with it.
  * @a startRound() must be called at the beginning of a round so that entries that are too old
- * can be purged. The current strategy is to store programs corresponding to all possible prefixes
+ * can be purged. By default the cache stores programs corresponding to all possible prefixes
  * encountered in the current and the previous rounds. Entries older than that get removed to
  * conserve memory.
  *
+ * If a limit on the total size of the cached programs is given, entries are instead kept across
+ * any number of rounds and are only purged when the limit is exceeded at the beginning of a round.
+ * The entries used least recently get removed first and an entry is never removed before any
+ * longer entry it is a prefix of. The limit is measured with @a CacheStats::StorageWeights and
+ * the cache may temporarily exceed it during a round.
+ *
  * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
  *
  * The current strategy does speed things up (about 4:1 hit:miss ratio observed in my limited
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
- *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _maxTotalCodeSize = std::nullopt):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -125,9 +132,12 @@ public:
 	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
 	size_t currentRound() const { return m_currentRound; }
+	std::optional<size_t> maxTotalCodeSize() const { return m_maxTotalCodeSize; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	/// Removes the least recently used entries until the total size of the cached programs
+	/// no longer exceeds @a m_maxTotalCodeSize.
+	void enforceSizeLimit();
 	std::map<size_t, size_t> countRoundEntries() const;
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
@@ -136,6 +146,8 @@ private:
 	std::map<std::string, CacheEntry> m_entries;
 
 	Program m_program;
+	std::optional<size_t> m_maxTotalCodeSize;
+	size_t m_totalCodeSize = 0;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;